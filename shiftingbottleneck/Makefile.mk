@@ -1,12 +1,21 @@
 CC = gcc
 CFLAGS = -g -I../include -fdiagnostics-color=always
+LDLIBS = -pthread -lm
 SOURCES = $(wildcard *.c)
 OUTPUT = main.exe
+BENCH_OUTPUT = bench.exe
+BENCH_ARGS = --save bench_results.txt
 
 all: $(OUTPUT)
 
 $(OUTPUT): $(SOURCES)
-	$(CC) $(CFLAGS) $(SOURCES) -o $(OUTPUT)
+	$(CC) $(CFLAGS) $(SOURCES) -o $(OUTPUT) $(LDLIBS)
+
+# Kernel microbenchmarks, optimized build. Compare against an earlier run with
+# make bench BENCH_ARGS="--baseline bench_results.txt"
+bench: $(SOURCES)
+	$(CC) $(CFLAGS) -O2 $(SOURCES) -o $(BENCH_OUTPUT) $(LDLIBS)
+	./$(BENCH_OUTPUT) --bench $(BENCH_ARGS)
 
 clean:
-	del /Q $(OUTPUT)
\ No newline at end of file
+	del /Q $(OUTPUT) $(BENCH_OUTPUT)
\ No newline at end of file
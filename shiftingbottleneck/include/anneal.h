@@ -0,0 +1,68 @@
+#ifndef ANNEAL_H
+#define ANNEAL_H
+
+#include <stdint.h>
+
+#include "main.h"
+#include "sequence.h"
+
+#define MAX_REPLICAS 64
+
+typedef struct {
+    MachineSequences current;
+    MachineSequences best;
+    int best_makespan;
+    uint64_t rng;
+    long long moves;
+    long long accepted;
+} ReplicaState;
+
+// A run captured at an exchange barrier, when no replica is mid-move: resuming from it
+// continues the exact same trajectory.
+typedef struct {
+    int num_replicas;
+    int round;
+    uint64_t exchange_rng;
+    long long exchanges_proposed;
+    long long exchanges_accepted;
+    double elapsed;                         // Seconds already spent, counted against the budget
+    double temperature[MAX_REPLICAS];
+    int replica_at_level[MAX_REPLICAS];
+    ReplicaState replicas[MAX_REPLICAS];
+} TemperingState;
+
+typedef struct {
+    int num_threads;            // Replicas, one per thread; 0 = one per online core
+    double seconds;             // Wall-clock budget
+    int moves_per_exchange;     // Moves each replica makes between two swap proposals
+    double t_min;               // Coldest temperature, as a fraction of the starting makespan
+    double t_max;               // Hottest temperature, same unit
+    unsigned long long seed;
+    const char* checkpoint_path;    // Periodic snapshots of the run, NULL for none
+    double checkpoint_interval;     // Seconds between two snapshots
+    const TemperingState* resume;   // Continue this run instead of starting from start (may be NULL)
+} AnnealParams;
+
+typedef struct {
+    int num_replicas;
+    int best_makespan;
+    long long moves;
+    long long accepted;
+    long long exchanges_proposed;
+    long long exchanges_accepted;
+    double elapsed;             // Seconds
+} AnnealStats;
+
+void default_anneal_params(AnnealParams* params);
+
+// Parallel-tempering simulated annealing over critical-arc swaps (N1 neighborhood),
+// one replica per thread, replicas exchanging temperatures at a barrier.
+// start must be an acyclic orientation (e.g. extracted from the SBP schedule); it is
+// ignored when params->resume is set.
+// Returns the best makespan found and its orientation in best.
+int parallel_tempering(const JSSPData* data, const MachineSequences* start, const AnnealParams* params,
+    MachineSequences* best, AnnealStats* stats);
+
+void print_anneal_stats(const AnnealStats* stats);
+
+#endif // ANNEAL_H
@@ -0,0 +1,24 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#define BENCH_DEFAULT_REPS 200
+#define BENCH_DEFAULT_THRESHOLD 10.0    // Percent slowdown of the median that counts as a regression
+#define BENCH_NAME_LEN 48
+
+typedef struct {
+    char name[BENCH_NAME_LEN];          // "<kernel>/<instance>", stable across runs
+    long long calls;
+    double median_ns;
+    double p99_ns;
+    double ops_per_sec;
+    double cycles_per_op;               // TSC ticks, 0 where no cycle counter is available
+} BenchResult;
+
+// Runs every solver kernel in isolation on fixed synthetic and real instances.
+// Usage: --bench [--reps <n>] [--filter <substring>] [--save <file>] [--baseline <file>] [--threshold <pct>]
+// Results are printed (and saved) one kernel per line, so two runs diff cleanly.
+// Returns: 0, or 1 if a kernel's median regressed past the threshold against the baseline
+// or a baseline kernel that --filter did not exclude was not measured.
+int run_benchmarks(int argc, char** argv);
+
+#endif // BENCH_H
@@ -0,0 +1,59 @@
+#ifndef BNB_H
+#define BNB_H
+
+#include <stdbool.h>
+
+#include "main.h"
+#include "sequence.h"
+
+#define MAX_SEARCH_THREADS 64
+
+// Open subtrees of a search, each given by the disjunctive arcs fixed on its way from the root.
+// Resuming from a frontier explores exactly the part of the tree that was still open.
+typedef struct {
+    int num_nodes;
+    int* num_arcs;          // Per node
+    int (*arcs)[2];         // The arcs of all nodes, back to back
+    long long total_arcs;
+    int node_capacity;
+    long long arc_capacity;
+    long long nodes;        // Counters so far
+    long long pruned;
+    long long steals;
+    int root_bound;
+    double elapsed;         // Seconds already spent, counted against the budget
+} SearchFrontier;
+
+typedef struct {
+    int num_threads;        // 0 = one per online core
+    double seconds;         // Wall-clock budget, <= 0 for no limit
+    const char* checkpoint_path;    // Periodic snapshots of the frontier, NULL for none
+    double checkpoint_interval;     // Seconds between two snapshots
+    const SearchFrontier* resume;   // Explore only this frontier (may be NULL)
+} BranchBoundParams;
+
+typedef struct {
+    int num_threads;
+    int best_makespan;
+    int root_bound;         // Lower bound at the root node
+    bool proven_optimal;    // Search tree exhausted within the budget
+    long long nodes;
+    long long pruned;
+    long long steals;
+    double elapsed;
+} BranchBoundStats;
+
+// Exact disjunctive branch-and-bound. Every node fixes a set of disjunctive arcs, is
+// tightened by propagation against the incumbent and bounded by the longest path and
+// one-machine preemptive bounds. Nodes branch on an undecided arc of a critical block
+// of a schedule built inside the node. Subtrees are spread over per-thread work-stealing
+// deques; the incumbent is a shared atomic.
+// incumbent/incumbent_makespan: starting solution and upper bound (e.g. SBP result);
+// NULL/-1 starts from the total work as bound.
+// Returns the best makespan; best receives its orientation.
+int branch_and_bound(const JSSPData* data, const MachineSequences* incumbent, int incumbent_makespan,
+    const BranchBoundParams* params, MachineSequences* best, BranchBoundStats* stats);
+
+void print_branch_bound_stats(const BranchBoundStats* stats);
+
+#endif // BNB_H
@@ -0,0 +1,60 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "main.h"
+#include "sequence.h"
+#include "anneal.h"
+#include "bnb.h"
+
+#define CHECKPOINT_DEFAULT_INTERVAL 10.0
+
+typedef enum {
+    CHECKPOINT_ANNEAL = 1,
+    CHECKPOINT_EXACT = 2
+} CheckpointPhase;
+
+// Solver state captured during a run: the incumbent and what its phase needs to go on.
+typedef struct {
+    CheckpointPhase phase;
+    int best_makespan;              // -1 if there is no incumbent yet
+    MachineSequences best;
+    TemperingState* tempering;      // CHECKPOINT_ANNEAL, allocated on first use
+    SearchFrontier frontier;        // CHECKPOINT_EXACT
+} Checkpoint;
+
+// Copies a running solver's state into checkpoint. Returns 0, or -1 to skip this snapshot.
+typedef int (*CaptureCheckpoint)(void* solver, Checkpoint* checkpoint);
+
+// Background thread that captures the solver every interval seconds and writes the
+// snapshot to path. Capturing only takes short locks inside the solver; the file is
+// written to path.tmp, synced and renamed over path, so path always holds a whole snapshot.
+typedef struct {
+    const char* path;
+    double interval;
+    const JSSPData* data;
+    CaptureCheckpoint capture;
+    void* solver;
+    Checkpoint snapshot;            // Reused between snapshots
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    bool stop;
+    int num_written;
+} Checkpointer;
+
+int start_checkpointer(Checkpointer* ck, const char* path, double interval, const JSSPData* data,
+    CaptureCheckpoint capture, void* solver);
+// Stops the thread; with final set, captures and writes one last snapshot first.
+// The solver's workers must have stopped before a final snapshot.
+void stop_checkpointer(Checkpointer* ck, bool final);
+
+// Returns 0, or -1 with a message on stderr.
+int write_checkpoint(const char* path, const JSSPData* data, const Checkpoint* checkpoint);
+// Fails (-1, message on stderr) unless the file is intact and was written for data.
+int read_checkpoint(const char* path, const JSSPData* data, Checkpoint* checkpoint);
+void free_checkpoint(Checkpoint* checkpoint);
+
+#endif // CHECKPOINT_H
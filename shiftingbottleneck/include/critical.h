@@ -0,0 +1,41 @@
+#ifndef CRITICAL_H
+#define CRITICAL_H
+
+#include <stdbool.h>
+
+#include "main.h"
+
+// Maximal run of consecutive critical-path operations on the same machine.
+typedef struct {
+    int machine;
+    int first;      // Index into CriticalPath.path
+    int length;
+} CriticalBlock;
+
+typedef struct {
+    // Cache key: recomputed when the graph, its size or its largest node stamp changes
+    const OperationNode* nodes;
+    int num_operations;
+    unsigned long version;
+    bool valid;
+
+    int makespan;
+    int head[MAX_OPERATIONS];           // Earliest start
+    int tail[MAX_OPERATIONS];           // Longest path from the op's completion to the end
+    int slack[MAX_OPERATIONS];          // makespan - head - duration - tail
+    int longest_pred[MAX_OPERATIONS];   // Predecessor on a longest path into the op, -1 at a source
+    int order[MAX_OPERATIONS];          // Topological order used by both passes
+
+    int path[MAX_OPERATIONS];           // Critical path, source to sink
+    int path_length;
+    CriticalBlock blocks[MAX_OPERATIONS];
+    int num_blocks;
+} CriticalPath;
+
+// Returns the critical path of the graph, computing it with one forward and one backward
+// pass only if the cached result is stale. Returns NULL if the graph has a cycle.
+const CriticalPath* get_critical_path(CriticalPath* cp, const OperationNode* nodes, int num_operations);
+void invalidate_critical_path(CriticalPath* cp);
+void print_critical_path(const CriticalPath* cp, const OperationNode* nodes, int num_machines);
+
+#endif // CRITICAL_H
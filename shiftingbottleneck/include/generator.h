@@ -0,0 +1,43 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <stddef.h>
+
+#include "main.h"
+
+#define GENERATED_SUBDIR "gen"
+
+typedef enum {
+    GEN_TAILLARD,       // Taillard (1993): uniform durations, random routings
+    GEN_FLOW_SHOP,      // Common routing 0..m-1 with a few adjacent swaps per job
+    GEN_BOTTLENECK      // Taillard routings, a tenth of the machines get doubled durations
+} GeneratorKind;
+
+typedef struct {
+    GeneratorKind kind;
+    int num_jobs;
+    int num_machines;
+    int min_duration;
+    int max_duration;
+    long time_seed;     // Drives durations
+    long machine_seed;  // Drives routings (Taillard keeps the two streams apart)
+} GeneratorParams;
+
+// Generates an instance in the layout returned by load_jssp_matrix (rows = jobs,
+// columns = machine/duration pairs). Not bounded by MAX_JOBS/MAX_MACHINES.
+// Free with free_matrix.
+int** generate_jssp_matrix(const GeneratorParams* params);
+
+// Same instance straight into a JSSPData. Returns -1 if it exceeds MAX_JOBS/MAX_MACHINES.
+int generate_jssp_data(const GeneratorParams* params, JSSPData* data);
+
+// Writes a matrix in the .jss text format read by load_jssp_matrix. Returns 0 on success.
+int write_jssp_file(const char* path, int** matrix, int num_jobs, int num_machines);
+
+// File name load_jssp_matrix resolves to JSSP_ROOT/gen/, e.g. "gen100x20_ta_42_7.jss".
+void format_generated_filename(char* out, size_t len, const GeneratorParams* params);
+
+const char* generator_kind_name(GeneratorKind kind);
+int parse_generator_kind(const char* name, GeneratorKind* kind);
+
+#endif // GENERATOR_H
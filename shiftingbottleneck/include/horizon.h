@@ -0,0 +1,36 @@
+#ifndef HORIZON_H
+#define HORIZON_H
+
+#include "main.h"
+
+#define HORIZON_DEFAULT_WINDOW MAX_JOBS  // Fewer jobs in flight starve the machines
+#define HORIZON_DEFAULT_COMMIT 0.5
+
+typedef struct {
+    int window_jobs;            // Jobs solved together, at most MAX_JOBS
+    double commit_fraction;     // Share of each window's time span that is frozen, (0, 1]
+} HorizonParams;
+
+typedef struct {
+    int num_windows;
+    int makespan;
+    long long swaps_accepted;   // Improving critical-arc swaps over all windows
+    double elapsed;             // Seconds
+} HorizonStats;
+
+// Rolling-horizon decomposition for instances larger than MAX_JOBS. A window holds the
+// unfinished jobs plus the next jobs in instance order, up to window_jobs. It is solved by
+// the shifting bottleneck procedure (or a release-aware dispatch when that is better),
+// evaluated behind the committed machine and job times and improved by critical-arc swaps.
+// Operations starting in the first commit_fraction of its time span are frozen, then the
+// window rolls forward.
+// Time and memory grow linearly with the number of jobs.
+// matrix: loader layout (rows = jobs, machine/duration pairs), num_machines <= MAX_MACHINES.
+// start_times: output, one row of num_machines start times per job; free with free_matrix.
+// Returns the makespan, or -1 on invalid parameters.
+int rolling_horizon(int** matrix, int num_jobs, int num_machines, const HorizonParams* params,
+    int*** start_times, HorizonStats* stats);
+
+void print_horizon_stats(const HorizonStats* stats);
+
+#endif // HORIZON_H
@@ -1,12 +1,13 @@
 #ifndef MAIN_H
 #define MAIN_H
 
+#include <stdbool.h>
+
 #define MAX_JOBS 50
 #define MAX_MACHINES 50
 #define MAX_OPS_PER_MACHINE (MAX_JOBS)
 #define MAX_OPERATIONS (MAX_JOBS * MAX_MACHINES)
 #define MAX_EDGES_PER_NODE (MAX_JOBS)  // upper bound on successors/predecessors
-#define MAX_DISJ_ARCS (MAX_MACHINES * MAX_JOBS * (MAX_JOBS - 1))
 
 typedef struct {
     int machine;
@@ -40,23 +41,59 @@ typedef struct {
 
     int earliest_start;    // For scheduling calculations
     int latest_finish;
+
+    unsigned long version; // Stamp of the last change to its arcs or duration, see touch_node
 } OperationNode;
 
+// Disjunctions are not materialized: every pair of operations in a machine's list is one,
+// and it counts as oriented once either direction is an arc of the OperationNode graph.
+typedef struct {
+    int machine_id;
+    int op_indices[MAX_OPS_PER_MACHINE];  // Indices into OperationNode[]
+    int num_ops;
+    bool sequenced;                        // Whole machine sequence committed by the SBP
+} MachineOps;
+
 typedef struct {
-    struct {
-        int from;
-        int to;
-    } arcs[MAX_DISJ_ARCS];
-    int num_arcs;
-} GraphData;
-
-// // This way we have a list of MachineOps (length = num_machines) where each entry contains the indices of operations that run on that machine.
-// typedef struct {
-//     int machine_id;
-//     int op_indices[MAX_OPERATIONS];  // Indices into OperationNode[]
-//     int num_ops;
-// } MachineOps;
-
-// Function prototypes (soon)
+    MachineOps machines[MAX_MACHINES];
+    int num_machines;
+} DisjunctiveSets;
+
+typedef enum {
+    DISJ_UNDECIDED,
+    DISJ_FORWARD,       // first -> second is an arc
+    DISJ_BACKWARD       // second -> first is an arc
+} DisjunctionState;
+
+// Generates the pairs of one machine (or of all machines) on demand.
+typedef struct {
+    int machine;
+    int last_machine;
+    int i, j;           // Positions in the machine's op_indices
+} DisjunctionIterator;
+
+// Step-by-step output of compute_shifting_bottleneck; drivers that run it many times turn it off.
+extern bool shifting_bottleneck_trace;
+
+// Function prototypes (graph helpers in main.c)
+void initialize_schedule_data(int** matrix, int num_jobs, int num_machines, JSSPData* data);
+int op_node_index(int job, int num_machines, int op);
+bool has_successor(OperationNode* node, int succ_id);
+bool has_predecessor(OperationNode* node, int pred_id);
+// Stamps a node whose arcs or duration changed. Stamps come from a per-thread clock that only
+// grows, so the largest stamp of a graph moves on every change made by the thread owning it;
+// caches derived from the graph (get_critical_path) compare it. Every mutator calls this.
+void touch_node(OperationNode* node);
+void add_successor_unique(OperationNode* node, int succ_id);
+void add_predecessor_unique(OperationNode* node, int pred_id);
+void build_disjunctive_graph(const JSSPData* data, OperationNode* nodes, int num_operations);
+void compute_earliest_start_times(OperationNode* nodes, int num_operations);
+void build_machine_ops(const OperationNode* nodes, int num_operations, int num_machines, DisjunctiveSets* sets);
+DisjunctionState disjunction_state(OperationNode* nodes, int first, int second);
+void init_disjunction_iterator(DisjunctionIterator* it, const DisjunctiveSets* sets, int machine);
+bool next_disjunction(const DisjunctiveSets* sets, DisjunctionIterator* it, int* first, int* second);
+int count_undecided_disjunctions(const DisjunctiveSets* sets, OperationNode* nodes);
+void fill_schedule_from_nodes(Schedule* sched, OperationNode* nodes, JSSPData* data);
+void compute_shifting_bottleneck(JSSPData* data, Schedule* sched);
 
 #endif
\ No newline at end of file
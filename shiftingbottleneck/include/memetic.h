@@ -0,0 +1,52 @@
+#ifndef MEMETIC_H
+#define MEMETIC_H
+
+#include "main.h"
+#include "sequence.h"
+
+#define MAX_POPULATION 256
+#define MAX_MEMETIC_THREADS 64
+
+typedef struct {
+    int num_threads;            // 0 = one per online core
+    double seconds;             // Wall-clock budget
+    int max_generations;        // Stop after this many generations too, 0 for no limit
+    int population;             // Chromosomes kept per generation, as many children bred
+    int descent_moves;          // Improving swaps per child at most
+    double mutation_rate;       // Chance that a child gets one random gene swap
+    unsigned long long seed;
+} MemeticParams;
+
+typedef struct {
+    int num_threads;
+    int population;
+    int generations;
+    int best_makespan;
+    long long children;
+    long long improving_moves;
+    double elapsed;             // Seconds
+} MemeticStats;
+
+void default_memetic_params(MemeticParams* params);
+
+// Giffler-Thompson decoding of an operation-based chromosome: job j appears num_machines
+// times and its k-th occurrence stands for its k-th operation. Among the operations that
+// could start before the earliest possible completion on that completion's machine, the
+// one whose gene comes first is scheduled, so the schedule is active.
+// seq receives the machine sequences. Returns the makespan.
+int decode_active_schedule(const JSSPData* data, const int* chromosome, MachineSequences* seq);
+
+// Memetic algorithm: POX crossover (precedence preserving: the genes of a random job subset
+// stay in place, the others follow the second parent's order), active decoding and a short
+// N1 descent on critical arcs whose result is written back into the chromosome.
+// Children are bred, decoded and improved in parallel; every thread owns an arena allocated
+// up front. Each child draws from its own generator, so a run depends on the seed and the
+// number of generations but not on the thread count.
+// seed: orientation to put into the first population, or NULL.
+// Returns the best makespan and writes its semi-active schedule to sched.
+int memetic_search(const JSSPData* data, const MachineSequences* seed, const MemeticParams* params,
+    Schedule* sched, MemeticStats* stats);
+
+void print_memetic_stats(const MemeticStats* stats);
+
+#endif // MEMETIC_H
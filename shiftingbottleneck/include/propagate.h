@@ -0,0 +1,43 @@
+#ifndef PROPAGATE_H
+#define PROPAGATE_H
+
+#include <stdbool.h>
+
+#include "main.h"
+
+#define PROPAGATION_INFEASIBLE (-1)
+
+// State kept between propagation passes so that only machines whose time windows
+// changed since the last call are filtered again.
+typedef struct {
+    int upper_bound;                    // Makespan bound every fixed arc is relative to
+    int num_machines;
+    int num_fixed;                      // Disjunctions settled over all calls
+    int release[MAX_OPERATIONS];        // Head lower bounds learned by not-first / edge-finding
+    int deadline[MAX_OPERATIONS];       // Latest-finish upper bounds learned by not-last / edge-finding
+    int last_head[MAX_OPERATIONS];      // Windows seen by the previous pass
+    int last_deadline[MAX_OPERATIONS];
+    bool machine_dirty[MAX_MACHINES];
+
+    // Scratch for one call; kept here so every thread can own a context
+    int head[MAX_OPERATIONS];
+    int lf[MAX_OPERATIONS];
+    int saved_succ[MAX_OPERATIONS];
+    int saved_pred[MAX_OPERATIONS];
+    int saved_release[MAX_OPERATIONS];
+    int saved_deadline[MAX_OPERATIONS];
+    DisjunctiveSets sets;
+} PropagationContext;
+
+void init_propagation(PropagationContext* ctx, int num_operations, int num_machines, int upper_bound);
+
+// Fixes every disjunctive arc implied by "makespan <= upper_bound" (pair rule, edge-finding,
+// not-first/not-last) until a fixpoint is reached. The arcs are added to nodes[].
+// Returns: number of disjunctions settled by this call, or PROPAGATION_INFEASIBLE
+// (the graph is left untouched in that case).
+int propagate_disjunctions(PropagationContext* ctx, OperationNode* nodes, int num_operations);
+
+// Makespan of a non-delay dispatching schedule, used as the initial bound.
+int greedy_upper_bound(const JSSPData* data);
+
+#endif // PROPAGATE_H
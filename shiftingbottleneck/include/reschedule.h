@@ -0,0 +1,66 @@
+#ifndef RESCHEDULE_H
+#define RESCHEDULE_H
+
+#include "main.h"
+#include "sequence.h"
+
+#define MAX_DOWNTIMES 64
+
+typedef struct {
+    int job;            // Job index in the previous instance
+    int op;
+    int duration;
+} DurationChange;
+
+// Machine unavailable during [from, to); operations are not preempted.
+typedef struct {
+    int machine;
+    int from;
+    int to;
+} MachineDowntime;
+
+// Everything that changed since the previous schedule was computed.
+typedef struct {
+    int num_removed;
+    int removed_jobs[MAX_JOBS];                 // Job indices in the previous instance
+    int num_added;
+    Task added_jobs[MAX_JOBS][MAX_MACHINES];    // Routings of the new jobs, one op per machine
+    int num_changes;
+    DurationChange changes[MAX_OPERATIONS];
+    int num_downtimes;
+    MachineDowntime downtimes[MAX_DOWNTIMES];
+} InstanceDelta;
+
+typedef struct {
+    int removed_ops;
+    int inserted_ops;
+    int pushed_ops;             // Right-shifted out of a downtime window
+    int impacted_machines;
+    long long swaps_tried;
+    long long swaps_accepted;
+    int makespan;
+    double elapsed;             // Seconds
+} RescheduleStats;
+
+// Repairs a previous orientation instead of solving the changed instance from scratch:
+// removed jobs are unlinked, new operations are inserted at their best position on their
+// machine, operations overlapping a downtime are right-shifted, and the machines touched
+// by the delta are re-optimized by critical-arc swaps. Every step re-evaluates only the
+// cone of the operations it moves.
+// new_data receives the changed instance (surviving jobs keep their order, added jobs
+// come last), sequences and sched its repaired orientation and schedule.
+// Returns the new makespan, or -1 if the delta or the previous orientation is invalid.
+int reschedule(const JSSPData* data, const MachineSequences* previous, const InstanceDelta* delta,
+    JSSPData* new_data, MachineSequences* sequences, Schedule* sched, RescheduleStats* stats);
+
+// Reads a delta, one change per line:
+//   remove <job>
+//   add <machine> <duration> ... (one pair per machine)
+//   duration <job> <op> <duration>
+//   down <machine> <from> <to>
+// Lines starting with '#' are ignored. Returns 0 on success.
+int load_instance_delta(const char* path, int num_machines, InstanceDelta* delta);
+
+void print_reschedule_stats(const RescheduleStats* stats);
+
+#endif // RESCHEDULE_H
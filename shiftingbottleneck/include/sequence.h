@@ -0,0 +1,76 @@
+#ifndef SEQUENCE_H
+#define SEQUENCE_H
+
+#include "main.h"
+
+// A complete orientation: the processing order of every machine.
+// Operations are node indices as given by op_node_index(job, num_machines, op).
+typedef struct {
+    int num_jobs;
+    int num_machines;
+    int order[MAX_MACHINES][MAX_OPS_PER_MACHINE];
+    int length[MAX_MACHINES];
+} MachineSequences;
+
+// Orientation held as per-machine linked lists with heads kept up to date, so that
+// swapping two adjacent operations only re-evaluates the operations reachable from them.
+// Everything below is owned by one thread; nothing is shared between graphs.
+typedef struct {
+    int num_jobs;
+    int num_machines;
+    int num_operations;
+    int duration[MAX_OPERATIONS];
+    int machine_of[MAX_OPERATIONS];
+    int release[MAX_OPERATIONS];        // Lower bound on every head (0 unless set by the caller)
+
+    int machine_first[MAX_MACHINES];
+    int machine_prev[MAX_OPERATIONS];
+    int machine_next[MAX_OPERATIONS];
+
+    int head[MAX_OPERATIONS];
+    int makespan;
+
+    // Scratch for the incremental evaluation and its undo
+    int cone[MAX_OPERATIONS];
+    int cone_size;
+    int cone_degree[MAX_OPERATIONS];
+    int queue[MAX_OPERATIONS];
+    int saved_head[MAX_OPERATIONS];
+    int saved_makespan;
+    unsigned int mark[MAX_OPERATIONS];
+    unsigned int stamp;
+    int last_swapped;                   // Operation that was moved back by the last swap, -1 if none
+} SequenceGraph;
+
+// Orders each machine's operations by start time in the schedule.
+void extract_machine_sequences(const Schedule* sched, const JSSPData* data, MachineSequences* seq);
+
+// Builds the semi-active schedule of the orientation. Returns its makespan, -1 on a cycle.
+int schedule_from_sequences(const MachineSequences* seq, const JSSPData* data, Schedule* sched);
+
+// Loads an orientation and evaluates it from scratch. Returns the makespan, -1 on a cycle.
+// Operations that appear in no sequence are left out of the machine lists.
+int load_sequence_graph(SequenceGraph* g, const JSSPData* data, const MachineSequences* seq);
+void store_sequence_graph(const SequenceGraph* g, MachineSequences* seq);
+
+// Full re-evaluation after the caller changed release[] or durations.
+int evaluate_sequence_graph(SequenceGraph* g);
+
+// Swaps u with its machine successor and re-evaluates only their cone.
+// Returns the new makespan, or -1 (and leaves the graph unchanged) if the swap closes a cycle.
+int swap_adjacent(SequenceGraph* g, int u);
+// Undoes the last successful swap_adjacent.
+void revert_swap(SequenceGraph* g);
+
+// Links an operation that is in no machine list (left out of the loaded sequences) at the
+// end of its machine, re-evaluating only its cone. Returns the new makespan.
+int append_operation(SequenceGraph* g, int x);
+
+// Raises release[x] and re-evaluates only its cone. Returns the new makespan.
+int set_release(SequenceGraph* g, int x, int release);
+
+// Collects the machine arcs (u, machine_next[u]) of one critical path; arcs[i] = u.
+// Returns the number of arcs found.
+int critical_machine_arcs(const SequenceGraph* g, int* arcs, int max_arcs);
+
+#endif // SEQUENCE_H
@@ -1,15 +1,109 @@
 #ifndef SSMS_H
 #define SSMS_H
 
+#include <stdint.h>
+#include <stdbool.h>
+
 #include "main.h"
 
 int solve_single_machine_subproblem_naive(OperationNode* nodes, int* ops_on_machine, int num_ops, int* best_sequence);
 
+// Path-induced precedences among one machine's operations (Dauzère-Pérès/Lasserre delayed
+// precedences): delay[i][j] >= 0 means ops_on_machine[i] reaches ops_on_machine[j] in the
+// graph, so j must follow i and start at least delay[i][j] after it; -1 otherwise.
+// Solvers that honor them never return a sequence that closes a cycle.
+typedef struct {
+    int num_ops;
+    int delay[MAX_OPS_PER_MACHINE][MAX_OPS_PER_MACHINE];
+} DelayedPrecedences;
+
+// order: a topological order of the acyclic graph, e.g. CriticalPath.order.
+void compute_delayed_precedences(OperationNode* nodes, const int* order, int num_operations, const int* ops_on_machine, int num_ops, DelayedPrecedences* delays);
+
 // Solves the sequencing subproblem for a single machine by brute force.
 // ops: array of OperationNode for the machine
 // n: number of operations
+// delays: delayed precedences to honor, or NULL to respect only direct arcs
 // best_sequence: output array of indices (length n) giving the best order
 // Returns: best makespan found
-int solve_single_machine_subproblem_bf(OperationNode* nodes, int* ops_on_machine, int n, int* best_sequence);
+int solve_single_machine_subproblem_bf(OperationNode* nodes, int* ops_on_machine, int n, const DelayedPrecedences* delays, int* best_sequence);
+
+// Largest load with size-specialized kernels (macro-generated in ssms.c, one per n):
+// evaluate_permutation and the brute force dispatch to them by operation count.
+#define SSMS_KERNEL_MAX_OPS 16
+
+// A machine's operations copied out of the graph, indexed by position in ops_on_machine.
+// predecessors[x] holds the positions that must precede x as a bit mask; x starts at
+// least delay[i][x] after each of them. Only the brute force fills the precedences.
+typedef struct {
+    int num_ops;
+    int release[SSMS_KERNEL_MAX_OPS];
+    int duration[SSMS_KERNEL_MAX_OPS];
+    uint32_t predecessors[SSMS_KERNEL_MAX_OPS];
+    int delay[SSMS_KERNEL_MAX_OPS][SSMS_KERNEL_MAX_OPS];
+} MachineLoad;
+
+// Copies releases (earliest_start) and durations into load. Returns false if n is 0 or above
+// SSMS_KERNEL_MAX_OPS, or if two operations share a job, which only the generic path models.
+bool load_machine_operations(const OperationNode* nodes, const int* ops_on_machine, int n, MachineLoad* load);
+
+// Makespan of a loaded machine in the order perm (positions in ops_on_machine), each
+// operation starting no earlier than its release. Callers evaluating many orders of one
+// machine load it once and call this.
+int evaluate_loaded_permutation(const MachineLoad* load, const int* perm);
+
+// Makespan of the machine when its operations run in the order ops_on_machine[perm[0..n-1]],
+// each starting no earlier than its earliest_start.
+int evaluate_permutation(OperationNode* nodes, int* ops_on_machine, const int* perm, int n);
+
+// Largest machine load still solved by brute force; heavier machines use Schrage.
+#define BF_MAX_OPS 8
+
+// Schrage's rule for the head-body-tail subproblem 1|r_j,q_j|Lmax: whenever the machine is free,
+// start the released operation with the largest tail.
+// head, tail: indexed by global node index
+// delays: delayed precedences to honor, or NULL
+// Returns: max over the machine of completion + tail
+int solve_single_machine_subproblem_schrage(OperationNode* nodes, int* ops_on_machine, int num_ops, const int* head, const int* tail, const DelayedPrecedences* delays, int* best_sequence);
+
+// Jackson's preemptive schedule on the head-body-tail relaxation: a lower bound on the
+// makespan of any orientation compatible with the given heads and tails.
+int one_machine_preemptive_bound(OperationNode* nodes, int* ops_on_machine, int num_ops, const int* head, const int* tail);
+
+// Sequences evaluated per evaluate_sequence_batch call, one per 32-bit SIMD lane:
+// two AVX2 or four SSE4.1 registers.
+#define SSMS_BATCH_LANES 16
+
+// Candidate sequences of one machine, transposed: row p holds, for every lane, the release,
+// duration and tail of the operation that lane processes at position p.
+typedef struct {
+    int num_ops;
+    int32_t release[MAX_OPS_PER_MACHINE][SSMS_BATCH_LANES];
+    int32_t duration[MAX_OPS_PER_MACHINE][SSMS_BATCH_LANES];
+    int32_t tail[MAX_OPS_PER_MACHINE][SSMS_BATCH_LANES];
+} SequenceBatch;
+
+typedef enum {
+    BATCH_SCALAR,
+    BATCH_SSE41,
+    BATCH_AVX2,
+    NUM_BATCH_ISAS
+} BatchIsa;
+
+// Per lane: Cmax, the last completion, and Lmax, the largest completion + tail, where every
+// operation starts at max(machine free, release). Runs the widest implementation the CPU
+// supports, picked once at startup.
+void evaluate_sequence_batch(const SequenceBatch* batch, int* cmax, int* lmax);
+// Same with a given implementation. Returns 0, or -1 if the CPU lacks it.
+int evaluate_sequence_batch_isa(BatchIsa isa, const SequenceBatch* batch, int* cmax, int* lmax);
+bool batch_isa_supported(BatchIsa isa);
+const char* batch_isa_name(BatchIsa isa);
+
+// Insertion descent for 1|r_j,q_j|Lmax started from sequence (e.g. Schrage's): moves one
+// operation elsewhere while that lowers max completion + tail. Every target position of an
+// operation is screened at once with evaluate_sequence_batch; the best one is checked with
+// the delayed precedences, which moves never break.
+// Returns: Lmax of the improved sequence, written back to sequence
+int improve_single_machine_sequence(OperationNode* nodes, int* ops_on_machine, int num_ops, const int* head, const int* tail, const DelayedPrecedences* delays, int* sequence);
 
 #endif // SSMS_H
\ No newline at end of file
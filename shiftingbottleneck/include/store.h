@@ -0,0 +1,66 @@
+#ifndef STORE_H
+#define STORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "main.h"
+#include "sequence.h"
+#include "file_utils.h"
+
+#define STORE_DEFAULT_DIR JSSP_ROOT "store"
+#define STORE_PATH_LEN 256
+
+// Index entry: the latest record of one instance and what it holds.
+typedef struct {
+    uint64_t hash;              // hash_jssp_data of the instance
+    uint64_t offset;            // Of the record in records.bin
+    int32_t makespan;
+    int32_t lower_bound;        // 0 if unknown
+    int32_t proven_optimal;
+    int32_t reserved;
+} StoreIndexEntry;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t num_entries;       // Sorted by hash after the header
+} StoreIndexHeader;
+
+// Best-known solutions across runs, in a directory holding two files:
+//   records.bin  append-only records (instance hash, makespan, bounds, machine sequences)
+//   index.bin    sorted hash -> latest record, mmapped read-only at open and replaced
+//                by writing a temporary file and renaming it over the old one
+// Updates take an exclusive flock on records.bin, so concurrent runs never lose a record.
+typedef struct {
+    char dir[STORE_PATH_LEN];
+    int records_fd;
+    const StoreIndexHeader* index;      // NULL while the store is empty
+    size_t index_size;
+} SolutionStore;
+
+typedef struct {
+    int makespan;               // -1 if the instance is not in the store
+    int lower_bound;
+    bool proven_optimal;
+} StoredBounds;
+
+// 64-bit FNV-1a over the dimensions and every (machine, duration) pair.
+uint64_t hash_jssp_data(const JSSPData* data);
+
+// Creates the directory and files if needed. Returns 0, or -1 with a message on stderr.
+int open_solution_store(const char* dir, SolutionStore* store);
+void close_solution_store(SolutionStore* store);
+
+// Reads the best stored orientation of data into seq (if not NULL).
+// Returns its makespan, -1 if there is none (bounds->makespan is -1 too).
+int lookup_best_solution(const SolutionStore* store, const JSSPData* data, MachineSequences* seq, StoredBounds* bounds);
+
+// Appends a record and publishes a new index if the solution or the bound improves on
+// the stored one; a better bound alone keeps the stored sequences. seq must be complete.
+// Returns 1 if the store changed, 0 if not, -1 on I/O errors.
+int record_solution(SolutionStore* store, const JSSPData* data, const MachineSequences* seq, int makespan,
+    int lower_bound, bool proven_optimal);
+
+#endif // STORE_H
@@ -0,0 +1,40 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+#include "main.h"
+
+#define MAX_REPORTED_VIOLATIONS 32
+
+typedef enum {
+    VIOLATION_BAD_TIMES,        // start < 0 or end - start != duration
+    VIOLATION_PRECEDENCE,       // op starts before its job predecessor ends
+    VIOLATION_MACHINE_OVERLAP,  // two ops overlap on the same machine
+    VIOLATION_READY_TIME,       // job_ready / machine_ready disagree with the end times
+    VIOLATION_MAKESPAN,         // claimed makespan differs from the latest end time
+    VIOLATION_BAD_MACHINE       // the instance gives an op a machine id outside [0, num_machines)
+} ViolationKind;
+
+typedef struct {
+    ViolationKind kind;
+    int job, op;                // Offending operation, -1 if none
+    int other_job, other_op;    // Conflicting operation (machine id in other_job for a machine ready time), -1 if none
+    int expected;
+    int actual;
+} ScheduleViolation;
+
+typedef struct {
+    int num_violations;         // Total found, can exceed num_reported
+    int num_reported;
+    int makespan;               // Latest end time in the schedule
+    ScheduleViolation violations[MAX_REPORTED_VIOLATIONS];
+} VerificationReport;
+
+// Checks durations, job precedence, machine overlap and ready-time/makespan consistency
+// in O(n log n). claimed_makespan < 0 skips the makespan comparison.
+// Returns: number of violations (0 means the schedule is feasible).
+int verify_schedule(const Schedule* sched, const JSSPData* data, int claimed_makespan, VerificationReport* report);
+// Same checks for instances beyond MAX_JOBS/MAX_MACHINES: start times next to the loader matrix.
+int verify_start_times(int** matrix, int** start_times, int num_jobs, int num_machines, int claimed_makespan, VerificationReport* report);
+void print_verification_report(const VerificationReport* report);
+
+#endif // VERIFY_H
@@ -0,0 +1,395 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "anneal.h"
+#include "checkpoint.h"
+
+#define CACHE_LINE 64
+
+// Everything a replica touches in its hot loop. Allocated per thread and cache-line
+// aligned, so replicas never share memory except at the exchange barrier.
+typedef struct {
+    SequenceGraph graph;
+    MachineSequences best;
+    int best_makespan;
+    int critical[MAX_OPERATIONS];
+    int num_critical;
+    bool critical_stale;
+    uint64_t rng;
+    long long moves;
+    long long accepted;
+} Replica;
+
+typedef struct {
+    const AnnealParams* params;
+    Replica* replicas[MAX_REPLICAS];
+    int num_replicas;
+    double temperature[MAX_REPLICAS];       // Per level, coldest first
+    int replica_at_level[MAX_REPLICAS];
+    int level_of_replica[MAX_REPLICAS];     // Only written by thread 0 between the two barriers
+    pthread_barrier_t barrier;
+    bool stop;
+    struct timespec start;
+    uint64_t exchange_rng;
+    long long exchanges_proposed;
+    long long exchanges_accepted;
+    int round;
+
+    // Snapshot handshake with the checkpoint thread: it raises snapshot_requested,
+    // thread 0 turns that into snapshot_due at the next exchange, and then every
+    // worker copies its own replica before moving on.
+    pthread_mutex_t snapshot_lock;
+    pthread_cond_t snapshot_done;
+    _Atomic bool snapshot_requested;
+    bool snapshot_due;                      // Only written by thread 0 between the two barriers
+    int snapshot_pending;                   // Replicas still copying, guarded by snapshot_lock
+    TemperingState* snapshot;
+    bool finished;                          // Workers have exited, guarded by snapshot_lock
+} Tempering;
+
+typedef struct {
+    Tempering* pt;
+    int replica;
+} WorkerArgs;
+
+void default_anneal_params(AnnealParams* params) {
+    params->num_threads = 0;
+    params->seconds = 5.0;
+    params->moves_per_exchange = 2000;
+    params->t_min = 0.002;
+    params->t_max = 0.03;
+    params->seed = 12345;
+    params->checkpoint_path = NULL;
+    params->checkpoint_interval = CHECKPOINT_DEFAULT_INTERVAL;
+    params->resume = NULL;
+}
+
+// xorshift64*
+static inline uint64_t next_random(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static inline double next_uniform(uint64_t* state) {
+    return (next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double seconds_since(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+/**
+ * One Metropolis step: swap a random critical arc, keep it or revert it.
+ * The makespan of the neighbor comes from the incremental cone update in swap_adjacent.
+ */
+static void anneal_move(Replica* r, double temperature) {
+    SequenceGraph* g = &r->graph;
+
+    if (r->critical_stale) {
+        r->num_critical = critical_machine_arcs(g, r->critical, MAX_OPERATIONS);
+        r->critical_stale = false;
+    }
+    r->moves++;
+    if (r->num_critical == 0) return;  // Critical path is a single job: the orientation is optimal
+
+    int u = r->critical[next_random(&r->rng) % r->num_critical];
+    int before = g->makespan;
+    int after = swap_adjacent(g, u);
+    if (after < 0) return;
+
+    int delta = after - before;
+    if (delta <= 0 || next_uniform(&r->rng) < exp(-delta / temperature)) {
+        r->accepted++;
+        r->critical_stale = true;
+        if (after < r->best_makespan) {
+            r->best_makespan = after;
+            store_sequence_graph(g, &r->best);
+        }
+    }
+    else {
+        revert_swap(g);
+    }
+}
+
+static void save_replica_state(const Replica* r, ReplicaState* state) {
+    store_sequence_graph(&r->graph, &state->current);
+    state->best = r->best;
+    state->best_makespan = r->best_makespan;
+    state->rng = r->rng;
+    state->moves = r->moves;
+    state->accepted = r->accepted;
+}
+
+// The part of the state that only changes at the exchange.
+static void save_exchange_state(const Tempering* pt, TemperingState* state) {
+    state->num_replicas = pt->num_replicas;
+    state->round = pt->round;
+    state->exchange_rng = pt->exchange_rng;
+    state->exchanges_proposed = pt->exchanges_proposed;
+    state->exchanges_accepted = pt->exchanges_accepted;
+    state->elapsed = seconds_since(&pt->start);
+    for (int k = 0; k < pt->num_replicas; k++) {
+        state->temperature[k] = pt->temperature[k];
+        state->replica_at_level[k] = pt->replica_at_level[k];
+    }
+}
+
+// Proposes swaps between neighboring temperature levels, alternating even and odd pairs.
+static void exchange_replicas(Tempering* pt) {
+    for (int k = pt->round % 2; k + 1 < pt->num_replicas; k += 2) {
+        int a = pt->replica_at_level[k];
+        int b = pt->replica_at_level[k + 1];
+        double energy_a = pt->replicas[a]->graph.makespan;
+        double energy_b = pt->replicas[b]->graph.makespan;
+        double log_ratio = (1.0 / pt->temperature[k] - 1.0 / pt->temperature[k + 1]) * (energy_a - energy_b);
+
+        pt->exchanges_proposed++;
+        if (log_ratio >= 0 || next_uniform(&pt->exchange_rng) < exp(log_ratio)) {
+            pt->exchanges_accepted++;
+            pt->replica_at_level[k] = b;
+            pt->replica_at_level[k + 1] = a;
+            pt->level_of_replica[a] = k + 1;
+            pt->level_of_replica[b] = k;
+        }
+    }
+    pt->round++;
+}
+
+static void* tempering_worker(void* arg) {
+    WorkerArgs* args = arg;
+    Tempering* pt = args->pt;
+    Replica* r = pt->replicas[args->replica];
+
+    for (;;) {
+        double temperature = pt->temperature[pt->level_of_replica[args->replica]];
+        for (int i = 0; i < pt->params->moves_per_exchange; i++) {
+            anneal_move(r, temperature);
+        }
+
+        // Only the swap proposal synchronizes
+        if (pthread_barrier_wait(&pt->barrier) == PTHREAD_BARRIER_SERIAL_THREAD) {
+            exchange_replicas(pt);
+            pt->stop = seconds_since(&pt->start) >= pt->params->seconds;
+            pt->snapshot_due = !pt->stop && atomic_load(&pt->snapshot_requested);
+            if (pt->snapshot_due) {
+                save_exchange_state(pt, pt->snapshot);
+                pt->snapshot_pending = pt->num_replicas;
+                atomic_store(&pt->snapshot_requested, false);
+            }
+        }
+        pthread_barrier_wait(&pt->barrier);
+
+        if (pt->snapshot_due) {
+            save_replica_state(r, &pt->snapshot->replicas[args->replica]);
+            pthread_mutex_lock(&pt->snapshot_lock);
+            if (--pt->snapshot_pending == 0) pthread_cond_signal(&pt->snapshot_done);
+            pthread_mutex_unlock(&pt->snapshot_lock);
+        }
+
+        if (pt->stop) break;
+    }
+    return NULL;
+}
+
+/**
+ * Checkpoint callback: waits for the next exchange, where every worker copies its own
+ * replica; once the run is over the idle replicas are copied directly.
+ */
+static int capture_tempering(void* solver, Checkpoint* checkpoint) {
+    Tempering* pt = solver;
+
+    if (checkpoint->tempering == NULL) checkpoint->tempering = malloc(sizeof(TemperingState));
+    TemperingState* state = checkpoint->tempering;
+
+    pthread_mutex_lock(&pt->snapshot_lock);
+    if (!pt->finished) {
+        pt->snapshot = state;
+        atomic_store(&pt->snapshot_requested, true);
+        while ((atomic_load(&pt->snapshot_requested) || pt->snapshot_pending > 0) && !pt->finished) {
+            pthread_cond_wait(&pt->snapshot_done, &pt->snapshot_lock);
+        }
+    }
+    if (pt->finished && (atomic_load(&pt->snapshot_requested) || pt->snapshot == NULL)) {
+        atomic_store(&pt->snapshot_requested, false);
+        save_exchange_state(pt, state);
+        for (int r = 0; r < pt->num_replicas; r++) {
+            save_replica_state(pt->replicas[r], &state->replicas[r]);
+        }
+    }
+    pt->snapshot = NULL;
+    pthread_mutex_unlock(&pt->snapshot_lock);
+
+    checkpoint->phase = CHECKPOINT_ANNEAL;
+    checkpoint->best_makespan = state->replicas[0].best_makespan;
+    checkpoint->best = state->replicas[0].best;
+    for (int r = 1; r < state->num_replicas; r++) {
+        if (state->replicas[r].best_makespan < checkpoint->best_makespan) {
+            checkpoint->best_makespan = state->replicas[r].best_makespan;
+            checkpoint->best = state->replicas[r].best;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Runs parallel tempering from the given orientation.
+ * @param data JSSP instance
+ * @param start Acyclic starting orientation (unused when resuming)
+ * @param params Thread count, time budget, temperature ladder, checkpoints
+ * @param best Output: best orientation over all replicas
+ * @param stats Output: move and exchange counters (may be NULL)
+ * @return best makespan, or -1 if start (or a resumed orientation) is not acyclic
+ */
+int parallel_tempering(const JSSPData* data, const MachineSequences* start, const AnnealParams* params,
+    MachineSequences* best, AnnealStats* stats) {
+    const TemperingState* resume = params->resume;
+    Tempering* pt = calloc(1, sizeof(Tempering));
+    pt->params = params;
+    pt->num_replicas = params->num_threads > 0 ? params->num_threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (resume != NULL) pt->num_replicas = resume->num_replicas;  // The ladder is part of the state
+    if (pt->num_replicas < 1) pt->num_replicas = 1;
+    if (pt->num_replicas > MAX_REPLICAS) pt->num_replicas = MAX_REPLICAS;
+    pt->exchange_rng = resume != NULL ? resume->exchange_rng : params->seed ^ 0x9E3779B97F4A7C15ULL;
+    pthread_mutex_init(&pt->snapshot_lock, NULL);
+    pthread_cond_init(&pt->snapshot_done, NULL);
+    atomic_init(&pt->snapshot_requested, false);
+
+    bool acyclic = true;
+    int start_makespan = -1;
+    for (int r = 0; r < pt->num_replicas; r++) {
+        size_t size = (sizeof(Replica) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+        Replica* replica = aligned_alloc(CACHE_LINE, size);
+        pt->replicas[r] = replica;
+
+        if (resume != NULL) {
+            const ReplicaState* state = &resume->replicas[r];
+            acyclic &= load_sequence_graph(&replica->graph, data, &state->current) >= 0;
+            replica->best = state->best;
+            replica->best_makespan = state->best_makespan;
+            replica->rng = state->rng;
+            replica->moves = state->moves;
+            replica->accepted = state->accepted;
+        }
+        else {
+            start_makespan = load_sequence_graph(&replica->graph, data, start);
+            acyclic &= start_makespan >= 0;
+            replica->best = *start;
+            replica->best_makespan = start_makespan;
+            replica->rng = params->seed + 0x9E3779B97F4A7C15ULL * (r + 1);
+            replica->moves = 0;
+            replica->accepted = 0;
+        }
+        replica->critical_stale = true;
+    }
+
+    int result = -1;
+    if (acyclic) {
+        if (resume != NULL) {
+            pt->round = resume->round;
+            pt->exchanges_proposed = resume->exchanges_proposed;
+            pt->exchanges_accepted = resume->exchanges_accepted;
+            for (int k = 0; k < pt->num_replicas; k++) {
+                pt->temperature[k] = resume->temperature[k];
+                pt->replica_at_level[k] = resume->replica_at_level[k];
+                pt->level_of_replica[resume->replica_at_level[k]] = k;
+            }
+        }
+        else {
+            // Geometric ladder, coldest level first
+            for (int k = 0; k < pt->num_replicas; k++) {
+                double fraction = pt->num_replicas > 1 ? (double)k / (pt->num_replicas - 1) : 0.0;
+                pt->temperature[k] = start_makespan * params->t_min * pow(params->t_max / params->t_min, fraction);
+                pt->replica_at_level[k] = k;
+                pt->level_of_replica[k] = k;
+            }
+        }
+
+        pthread_t threads[MAX_REPLICAS];
+        WorkerArgs args[MAX_REPLICAS];
+        pthread_barrier_init(&pt->barrier, NULL, pt->num_replicas);
+        clock_gettime(CLOCK_MONOTONIC, &pt->start);
+        if (resume != NULL) {
+            // The budget covers the time spent before the checkpoint too
+            pt->start.tv_sec -= (time_t)resume->elapsed;
+            pt->start.tv_nsec -= (long)((resume->elapsed - (time_t)resume->elapsed) * 1e9);
+            if (pt->start.tv_nsec < 0) {
+                pt->start.tv_sec--;
+                pt->start.tv_nsec += 1000000000L;
+            }
+        }
+
+        Checkpointer checkpointer;
+        bool checkpointing = params->checkpoint_path != NULL
+            && start_checkpointer(&checkpointer, params->checkpoint_path, params->checkpoint_interval,
+                data, capture_tempering, pt) == 0;
+
+        for (int r = 0; r < pt->num_replicas; r++) {
+            args[r].pt = pt;
+            args[r].replica = r;
+            pthread_create(&threads[r], NULL, tempering_worker, &args[r]);
+        }
+        for (int r = 0; r < pt->num_replicas; r++) {
+            pthread_join(threads[r], NULL);
+        }
+        pthread_barrier_destroy(&pt->barrier);
+
+        // Releases a snapshot request the workers exited before serving
+        pthread_mutex_lock(&pt->snapshot_lock);
+        pt->finished = true;
+        pthread_cond_signal(&pt->snapshot_done);
+        pthread_mutex_unlock(&pt->snapshot_lock);
+        if (checkpointing) stop_checkpointer(&checkpointer, true);
+
+        int winner = 0;
+        for (int r = 1; r < pt->num_replicas; r++) {
+            if (pt->replicas[r]->best_makespan < pt->replicas[winner]->best_makespan) winner = r;
+        }
+        *best = pt->replicas[winner]->best;
+        result = pt->replicas[winner]->best_makespan;
+
+        if (stats != NULL) {
+            stats->num_replicas = pt->num_replicas;
+            stats->best_makespan = result;
+            stats->moves = 0;
+            stats->accepted = 0;
+            for (int r = 0; r < pt->num_replicas; r++) {
+                stats->moves += pt->replicas[r]->moves;
+                stats->accepted += pt->replicas[r]->accepted;
+            }
+            stats->exchanges_proposed = pt->exchanges_proposed;
+            stats->exchanges_accepted = pt->exchanges_accepted;
+            stats->elapsed = seconds_since(&pt->start);
+        }
+    }
+
+    for (int r = 0; r < pt->num_replicas; r++) {
+        free(pt->replicas[r]);
+    }
+    pthread_mutex_destroy(&pt->snapshot_lock);
+    pthread_cond_destroy(&pt->snapshot_done);
+    free(pt);
+    return result;
+}
+
+void print_anneal_stats(const AnnealStats* stats) {
+    printf("Parallel tempering: %d replicas, %.2f s, best makespan %d\n",
+        stats->num_replicas, stats->elapsed, stats->best_makespan);
+    printf("  Moves: %lld (%.0f/s, %.0f/s per replica), accepted %.1f%%\n",
+        stats->moves, stats->moves / stats->elapsed, stats->moves / stats->elapsed / stats->num_replicas,
+        stats->moves > 0 ? 100.0 * stats->accepted / stats->moves : 0.0);
+    printf("  Exchanges: %lld proposed, %lld accepted\n", stats->exchanges_proposed, stats->exchanges_accepted);
+}
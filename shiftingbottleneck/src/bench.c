@@ -0,0 +1,492 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "bench.h"
+#include "main.h"
+#include "ssms.h"
+#include "critical.h"
+#include "memetic.h"
+#include "generator.h"
+#include "file_utils.h"
+
+#define WARMUP_SAMPLES 20
+#define TARGET_SAMPLE_NS 50000.0        // Calls are batched until one sample lasts this long
+#define MAX_BATCH (1 << 20)
+#define REAL_INSTANCE "ft06.jss"
+#define BF_BENCH_OPS BF_MAX_OPS         // Largest load the SBP still hands to brute force
+#define BF_LARGE_BENCH_OPS 10
+
+// One instance prepared for every kernel; kernels only read it or write its scratch.
+typedef struct {
+    JSSPData data;
+    int num_operations;
+    OperationNode nodes[MAX_OPERATIONS];        // Job arcs only, ESTs computed
+    OperationNode oriented[MAX_OPERATIONS];     // Every machine sequenced by job index (acyclic)
+    OperationNode scratch[MAX_OPERATIONS];
+    CriticalPath heads_tails;                   // Of nodes: heads and tails for the subproblems
+    CriticalPath critical;
+    DelayedPrecedences delays;                  // Of machine 0 in oriented
+    int machine_ops[MAX_OPS_PER_MACHINE];       // Operations of machine 0
+    int num_machine_ops;
+    int identity[MAX_OPS_PER_MACHINE];
+    int sequence[MAX_OPS_PER_MACHINE];
+    MachineLoad load;                           // Machine 0 of nodes, when it has a kernel
+    int rotations[SSMS_BATCH_LANES][MAX_OPS_PER_MACHINE];  // Machine 0 sequences, one per lane
+    SequenceBatch batch;                        // The same sequences transposed, with heads and tails
+    int cmax[SSMS_BATCH_LANES];
+    int lmax[SSMS_BATCH_LANES];
+    int chromosome[MAX_OPERATIONS];             // Jobs round robin, one gene per operation
+    MachineSequences decoded;
+    Schedule sched;
+} BenchFixture;
+
+typedef struct {
+    const char* kernel;
+    int fixture;                                // Index into the fixture table, -1 for none
+    int (*run)(BenchFixture* f);
+    bool quiet;                                 // Kernel prints: send stdout to /dev/null while timing
+    bool (*available)(void);                    // NULL, or false when the CPU cannot run the kernel
+} BenchCase;
+
+static const GeneratorParams fixture_params[] = {
+    { GEN_TAILLARD, 15, 15, 1, 99, 840612802, 398197754 },      // ta01
+    { GEN_TAILLARD, 50, 20, 1, 99, 1939, 8001 },
+};
+static const char* fixture_names[] = { "ta15x15", "ta50x20" };
+#define NUM_FIXTURES ((int)(sizeof(fixture_params) / sizeof(fixture_params[0])))
+
+static volatile int sink;                       // Keeps kernel results alive
+
+static inline uint64_t read_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static inline double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int setup_fixture(BenchFixture* f, const GeneratorParams* params) {
+    if (generate_jssp_data(params, &f->data) != 0) return -1;
+    f->num_operations = f->data.num_jobs * f->data.num_machines;
+
+    build_disjunctive_graph(&f->data, f->nodes, f->num_operations);
+    compute_earliest_start_times(f->nodes, f->num_operations);
+    if (get_critical_path(&f->heads_tails, f->nodes, f->num_operations) == NULL) return -1;
+
+    // Job-index order on every machine: all arcs point to a higher job, so no cycle
+    memcpy(f->oriented, f->nodes, sizeof(OperationNode) * f->num_operations);
+    int last_on_machine[MAX_MACHINES];
+    for (int m = 0; m < f->data.num_machines; m++) last_on_machine[m] = -1;
+    for (int x = 0; x < f->num_operations; x++) {
+        int m = f->oriented[x].machine;
+        if (last_on_machine[m] >= 0) {
+            add_successor_unique(&f->oriented[last_on_machine[m]], x);
+            add_predecessor_unique(&f->oriented[x], last_on_machine[m]);
+        }
+        last_on_machine[m] = x;
+    }
+
+    f->num_machine_ops = 0;
+    for (int x = 0; x < f->num_operations; x++) {
+        if (f->nodes[x].machine == 0) f->machine_ops[f->num_machine_ops++] = x;
+    }
+    for (int i = 0; i < MAX_OPS_PER_MACHINE; i++) f->identity[i] = i;
+
+    if (get_critical_path(&f->critical, f->oriented, f->num_operations) == NULL) return -1;
+    compute_delayed_precedences(f->oriented, f->critical.order, f->num_operations, f->machine_ops, f->num_machine_ops, &f->delays);
+
+    load_machine_operations(f->nodes, f->machine_ops, f->num_machine_ops, &f->load);
+
+    f->batch.num_ops = f->num_machine_ops;
+    for (int l = 0; l < SSMS_BATCH_LANES; l++) {
+        for (int p = 0; p < f->num_machine_ops; p++) {
+            int i = (p + l) % f->num_machine_ops;
+            int x = f->machine_ops[i];
+            f->rotations[l][p] = i;
+            f->batch.release[p][l] = f->heads_tails.head[x];
+            f->batch.duration[p][l] = f->nodes[x].duration;
+            f->batch.tail[p][l] = f->heads_tails.tail[x];
+        }
+    }
+
+    for (int p = 0; p < f->num_operations; p++) f->chromosome[p] = p % f->data.num_jobs;
+    return 0;
+}
+
+static int bench_load_jssp_matrix(BenchFixture* f) {
+    (void)f;
+    int num_jobs = 0, num_machines = 0, optimum = -1;
+    int** matrix = load_jssp_matrix(REAL_INSTANCE, &num_jobs, &num_machines, &optimum);
+    if (matrix == NULL) return -1;
+    int checksum = matrix[num_jobs - 1][2 * num_machines - 1];
+    free_matrix(matrix, num_jobs);
+    return checksum;
+}
+
+static int bench_build_disjunctive_graph(BenchFixture* f) {
+    build_disjunctive_graph(&f->data, f->scratch, f->num_operations);
+    return f->scratch[f->num_operations - 1].num_predecessors;
+}
+
+static int bench_compute_earliest_start_times(BenchFixture* f) {
+    compute_earliest_start_times(f->oriented, f->num_operations);
+    return f->oriented[f->num_operations - 1].earliest_start;
+}
+
+// Stamping one node stands in for an arc change, so every call runs both passes
+static int bench_get_critical_path(BenchFixture* f) {
+    touch_node(&f->oriented[0]);
+    return get_critical_path(&f->critical, f->oriented, f->num_operations)->makespan;
+}
+
+// Unchanged graph: what a repeated query costs once the path is cached
+static int bench_get_critical_path_cached(BenchFixture* f) {
+    return get_critical_path(&f->critical, f->oriented, f->num_operations)->makespan;
+}
+
+static int bench_evaluate_permutation(BenchFixture* f) {
+    return evaluate_permutation(f->nodes, f->machine_ops, f->identity, f->num_machine_ops);
+}
+
+// What the batch replaces: the same SSMS_BATCH_LANES sequences one call at a time
+static int bench_evaluate_permutation_lanes(BenchFixture* f) {
+    int worst = 0;
+    for (int l = 0; l < SSMS_BATCH_LANES; l++) {
+        int makespan = evaluate_permutation(f->nodes, f->machine_ops, f->rotations[l], f->num_machine_ops);
+        if (makespan > worst) worst = makespan;
+    }
+    return worst;
+}
+
+// The same lanes from one load: what callers evaluating many orders of a machine pay
+static int bench_evaluate_loaded_permutation_lanes(BenchFixture* f) {
+    int worst = 0;
+    for (int l = 0; l < SSMS_BATCH_LANES; l++) {
+        int makespan = evaluate_loaded_permutation(&f->load, f->rotations[l]);
+        if (makespan > worst) worst = makespan;
+    }
+    return worst;
+}
+
+static int bench_evaluate_batch(BenchFixture* f, BatchIsa isa) {
+    evaluate_sequence_batch_isa(isa, &f->batch, f->cmax, f->lmax);
+    return f->lmax[SSMS_BATCH_LANES - 1];
+}
+
+static int bench_evaluate_batch_scalar(BenchFixture* f) { return bench_evaluate_batch(f, BATCH_SCALAR); }
+static int bench_evaluate_batch_sse41(BenchFixture* f) { return bench_evaluate_batch(f, BATCH_SSE41); }
+static int bench_evaluate_batch_avx2(BenchFixture* f) { return bench_evaluate_batch(f, BATCH_AVX2); }
+static bool have_sse41(void) { return batch_isa_supported(BATCH_SSE41); }
+static bool have_avx2(void) { return batch_isa_supported(BATCH_AVX2); }
+
+static int bench_compute_delayed_precedences(BenchFixture* f) {
+    compute_delayed_precedences(f->oriented, f->critical.order, f->num_operations, f->machine_ops, f->num_machine_ops, &f->delays);
+    return f->delays.delay[0][f->num_machine_ops - 1];
+}
+
+static int bench_solve_bf(BenchFixture* f) {
+    int n = f->num_machine_ops < BF_BENCH_OPS ? f->num_machine_ops : BF_BENCH_OPS;
+    return solve_single_machine_subproblem_bf(f->nodes, f->machine_ops, n, NULL, f->sequence);
+}
+
+// Past BF_MAX_OPS: only direct callers reach these kernels, the SBP hands such loads to Schrage
+static int bench_solve_bf_large(BenchFixture* f) {
+    int n = f->num_machine_ops < BF_LARGE_BENCH_OPS ? f->num_machine_ops : BF_LARGE_BENCH_OPS;
+    return solve_single_machine_subproblem_bf(f->nodes, f->machine_ops, n, NULL, f->sequence);
+}
+
+static int bench_solve_schrage(BenchFixture* f) {
+    return solve_single_machine_subproblem_schrage(f->nodes, f->machine_ops, f->num_machine_ops,
+        f->heads_tails.head, f->heads_tails.tail, NULL, f->sequence);
+}
+
+static int bench_improve_sequence(BenchFixture* f) {
+    solve_single_machine_subproblem_schrage(f->nodes, f->machine_ops, f->num_machine_ops,
+        f->heads_tails.head, f->heads_tails.tail, NULL, f->sequence);
+    return improve_single_machine_sequence(f->nodes, f->machine_ops, f->num_machine_ops,
+        f->heads_tails.head, f->heads_tails.tail, NULL, f->sequence);
+}
+
+static int bench_preemptive_bound(BenchFixture* f) {
+    return one_machine_preemptive_bound(f->nodes, f->machine_ops, f->num_machine_ops,
+        f->heads_tails.head, f->heads_tails.tail);
+}
+
+static int bench_decode_active_schedule(BenchFixture* f) {
+    return decode_active_schedule(&f->data, f->chromosome, &f->decoded);
+}
+
+// The two whole solvers head to head; the memetic run is cut to a budget close to one SBP call
+static int bench_compute_shifting_bottleneck(BenchFixture* f) {
+    compute_shifting_bottleneck(&f->data, &f->sched);
+    return f->sched.machine_ready[0];
+}
+
+static int bench_memetic_search(BenchFixture* f) {
+    MemeticParams params;
+    default_memetic_params(&params);
+    params.num_threads = 1;
+    params.seconds = 1e9;
+    params.max_generations = 4;
+    params.population = 16;
+    return memetic_search(&f->data, NULL, &params, &f->sched, NULL);
+}
+
+static const BenchCase cases[] = {
+    { "load_jssp_matrix", -1, bench_load_jssp_matrix, true, NULL },
+    { "build_disjunctive_graph", 0, bench_build_disjunctive_graph, false, NULL },
+    { "build_disjunctive_graph", 1, bench_build_disjunctive_graph, false, NULL },
+    { "compute_earliest_start_times", 0, bench_compute_earliest_start_times, false, NULL },
+    { "compute_earliest_start_times", 1, bench_compute_earliest_start_times, false, NULL },
+    { "get_critical_path", 0, bench_get_critical_path, false, NULL },
+    { "get_critical_path", 1, bench_get_critical_path, false, NULL },
+    { "get_critical_path_cached", 0, bench_get_critical_path_cached, false, NULL },
+    { "get_critical_path_cached", 1, bench_get_critical_path_cached, false, NULL },
+    { "evaluate_permutation", 0, bench_evaluate_permutation, false, NULL },
+    { "evaluate_permutation", 1, bench_evaluate_permutation, false, NULL },
+    { "evaluate_permutation_x16", 0, bench_evaluate_permutation_lanes, false, NULL },
+    { "evaluate_permutation_x16", 1, bench_evaluate_permutation_lanes, false, NULL },
+    { "evaluate_loaded_permutation_x16", 0, bench_evaluate_loaded_permutation_lanes, false, NULL },
+    { "evaluate_sequence_batch_scalar", 0, bench_evaluate_batch_scalar, false, NULL },
+    { "evaluate_sequence_batch_scalar", 1, bench_evaluate_batch_scalar, false, NULL },
+    { "evaluate_sequence_batch_sse41", 0, bench_evaluate_batch_sse41, false, have_sse41 },
+    { "evaluate_sequence_batch_sse41", 1, bench_evaluate_batch_sse41, false, have_sse41 },
+    { "evaluate_sequence_batch_avx2", 0, bench_evaluate_batch_avx2, false, have_avx2 },
+    { "evaluate_sequence_batch_avx2", 1, bench_evaluate_batch_avx2, false, have_avx2 },
+    { "compute_delayed_precedences", 0, bench_compute_delayed_precedences, false, NULL },
+    { "compute_delayed_precedences", 1, bench_compute_delayed_precedences, false, NULL },
+    { "solve_single_machine_bf", 0, bench_solve_bf, false, NULL },
+    { "solve_single_machine_bf_10", 0, bench_solve_bf_large, false, NULL },
+    { "solve_single_machine_schrage", 0, bench_solve_schrage, false, NULL },
+    { "solve_single_machine_schrage", 1, bench_solve_schrage, false, NULL },
+    { "improve_single_machine_sequence", 0, bench_improve_sequence, false, NULL },
+    { "improve_single_machine_sequence", 1, bench_improve_sequence, false, NULL },
+    { "one_machine_preemptive_bound", 0, bench_preemptive_bound, false, NULL },
+    { "one_machine_preemptive_bound", 1, bench_preemptive_bound, false, NULL },
+    { "decode_active_schedule", 0, bench_decode_active_schedule, false, NULL },
+    { "decode_active_schedule", 1, bench_decode_active_schedule, false, NULL },
+    { "compute_shifting_bottleneck", 0, bench_compute_shifting_bottleneck, true, NULL },
+    { "memetic_search", 0, bench_memetic_search, false, NULL },
+};
+#define NUM_CASES ((int)(sizeof(cases) / sizeof(cases[0])))
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Stdout redirection for kernels that print; returns the saved descriptor.
+static int silence_stdout(void) {
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+    return saved;
+}
+
+static void restore_stdout(int saved) {
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+}
+
+/**
+ * Times one kernel: calibrates a batch size, warms up, then takes reps samples.
+ * @param bc Kernel to run
+ * @param f Its fixture (may be NULL)
+ * @param reps Number of timed samples
+ * @param result Output: per-call statistics
+ */
+static void measure_kernel(const BenchCase* bc, BenchFixture* f, int reps, BenchResult* result) {
+    double* ns = malloc(reps * sizeof(double));
+    double* cycles = malloc(reps * sizeof(double));
+
+    sink = bc->run(f);  // Cold call: page faults and cache misses would skew the calibration
+
+    int batch = 1;
+    for (;;) {
+        double start = now_ns();
+        for (int i = 0; i < batch; i++) sink = bc->run(f);
+        if (now_ns() - start >= TARGET_SAMPLE_NS || batch >= MAX_BATCH) break;
+        batch *= 2;
+    }
+
+    for (int s = -WARMUP_SAMPLES; s < reps; s++) {
+        uint64_t c0 = read_cycles();
+        double t0 = now_ns();
+        for (int i = 0; i < batch; i++) sink = bc->run(f);
+        double t1 = now_ns();
+        uint64_t c1 = read_cycles();
+        if (s < 0) continue;
+        ns[s] = (t1 - t0) / batch;
+        cycles[s] = (double)(c1 - c0) / batch;
+    }
+
+    qsort(ns, reps, sizeof(double), compare_doubles);
+    qsort(cycles, reps, sizeof(double), compare_doubles);
+    int p99 = (reps * 99) / 100;
+    if (p99 >= reps) p99 = reps - 1;
+
+    result->calls = (long long)reps * batch;
+    result->median_ns = ns[reps / 2];
+    result->p99_ns = ns[p99];
+    result->ops_per_sec = result->median_ns > 0 ? 1e9 / result->median_ns : 0;
+    result->cycles_per_op = cycles[reps / 2];
+
+    free(ns);
+    free(cycles);
+}
+
+static void print_result(FILE* out, const BenchResult* r) {
+    fprintf(out, "%-44s %10lld %12.1f %12.1f %14.1f %12.1f\n",
+        r->name, r->calls, r->median_ns, r->p99_ns, r->ops_per_sec, r->cycles_per_op);
+}
+
+static void print_header(FILE* out) {
+    fprintf(out, "# %-42s %10s %12s %12s %14s %12s\n", "kernel/instance", "calls", "median_ns", "p99_ns", "ops/s", "cycles/op");
+}
+
+static int save_results(const char* path, const BenchResult* results, int num_results) {
+    FILE* out = fopen(path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "Could not write benchmark results to %s\n", path);
+        return -1;
+    }
+    print_header(out);
+    for (int i = 0; i < num_results; i++) print_result(out, &results[i]);
+    fclose(out);
+    printf("Saved results to %s\n", path);
+    return 0;
+}
+
+/**
+ * Compares the medians against a file written by --save. A baseline kernel that this run
+ * did not measure counts as a failure too, unless the filter left it out.
+ * @return number of kernels slower than the baseline by more than threshold percent,
+ *         plus the number of baseline kernels missing from this run
+ */
+static int compare_with_baseline(const char* path, const BenchResult* results, int num_results, double threshold,
+    const char* filter) {
+    FILE* in = fopen(path, "r");
+    if (in == NULL) {
+        printf("No baseline at %s, skipping comparison\n", path);
+        return 0;
+    }
+
+    printf("\n# %-42s %12s %12s %9s\n", "kernel/instance", "base_ns", "median_ns", "delta");
+    int regressions = 0;
+    int missing = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), in)) {
+        char name[BENCH_NAME_LEN];
+        long long calls;
+        double base_median;
+        if (line[0] == '#' || sscanf(line, "%47s %lld %lf", name, &calls, &base_median) != 3) continue;
+
+        bool found = false;
+        for (int i = 0; i < num_results; i++) {
+            if (strcmp(results[i].name, name) != 0) continue;
+            found = true;
+            double delta = base_median > 0 ? 100.0 * (results[i].median_ns - base_median) / base_median : 0.0;
+            bool regressed = delta > threshold;
+            regressions += regressed;
+            printf("%-44s %12.1f %12.1f %+8.1f%%%s\n", name, base_median, results[i].median_ns, delta,
+                regressed ? "  REGRESSION" : "");
+        }
+        if (!found && (filter == NULL || strstr(name, filter) != NULL)) {
+            missing++;
+            printf("%-44s %12.1f %12s %9s  MISSING\n", name, base_median, "-", "-");
+        }
+    }
+    fclose(in);
+
+    if (regressions > 0) printf("%d kernel(s) regressed by more than %.1f%%\n", regressions, threshold);
+    if (missing > 0) printf("%d baseline kernel(s) not measured in this run (renamed, dropped or skipped)\n", missing);
+    return regressions + missing;
+}
+
+int run_benchmarks(int argc, char** argv) {
+    int reps = BENCH_DEFAULT_REPS;
+    double threshold = BENCH_DEFAULT_THRESHOLD;
+    const char* filter = NULL;
+    const char* save_path = NULL;
+    const char* baseline_path = NULL;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) reps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) filter = argv[++i];
+        else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc) save_path = argv[++i];
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) baseline_path = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) threshold = atof(argv[++i]);
+        else {
+            fprintf(stderr, "Usage: --bench [--reps <n>] [--filter <substring>] [--save <file>] [--baseline <file>] [--threshold <pct>]\n");
+            return EXIT_FAILURE;
+        }
+    }
+    if (reps < 1) reps = 1;
+
+    BenchFixture* fixtures = calloc(NUM_FIXTURES, sizeof(BenchFixture));  // Zeroed critical path caches
+    for (int k = 0; k < NUM_FIXTURES; k++) {
+        if (setup_fixture(&fixtures[k], &fixture_params[k]) != 0) {
+            fprintf(stderr, "Could not set up benchmark instance %s\n", fixture_names[k]);
+            free(fixtures);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // The real instance is optional: it depends on the data tree next to the binary
+    int saved = silence_stdout();
+    bool have_real_instance = bench_load_jssp_matrix(NULL) >= 0;
+    restore_stdout(saved);
+
+    BenchResult results[NUM_CASES];             // One per case, so no case is ever dropped
+    int num_results = 0;
+
+    print_header(stdout);
+    for (int c = 0; c < NUM_CASES; c++) {
+        const BenchCase* bc = &cases[c];
+        BenchResult* r = &results[num_results];
+        const char* instance = bc->fixture >= 0 ? fixture_names[bc->fixture] : "ft06";
+        snprintf(r->name, sizeof(r->name), "%s/%s", bc->kernel, instance);
+
+        if (filter != NULL && strstr(r->name, filter) == NULL) continue;
+        if (bc->fixture < 0 && !have_real_instance) {
+            printf("# %s skipped: %s not found under %s\n", r->name, REAL_INSTANCE, JSSP_ROOT);
+            continue;
+        }
+        if (bc->available != NULL && !bc->available()) {
+            printf("# %s skipped: not supported by this CPU\n", r->name);
+            continue;
+        }
+
+        BenchFixture* f = bc->fixture >= 0 ? &fixtures[bc->fixture] : NULL;
+        if (bc->quiet) saved = silence_stdout();
+        measure_kernel(bc, f, reps, r);
+        if (bc->quiet) restore_stdout(saved);
+
+        print_result(stdout, r);
+        fflush(stdout);
+        num_results++;
+    }
+    free(fixtures);
+
+    if (save_path != NULL) save_results(save_path, results, num_results);
+    int regressions = baseline_path != NULL ? compare_with_baseline(baseline_path, results, num_results, threshold, filter) : 0;
+    return regressions > 0 ? 1 : 0;
+}
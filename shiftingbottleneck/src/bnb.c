@@ -0,0 +1,522 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "bnb.h"
+#include "ssms.h"
+#include "propagate.h"
+#include "critical.h"
+#include "checkpoint.h"
+
+#define INITIAL_DEQUE_CAPACITY 64
+
+typedef struct {
+    int num_arcs;
+    int (*arcs)[2];             // Disjunctive arcs fixed on the way from the root
+} SearchNode;
+
+typedef struct {
+    pthread_mutex_t lock;
+    SearchNode** items;
+    int head;                   // Thieves take the oldest (largest) subtrees here
+    int tail;                   // The owner pushes and pops here, depth first
+    int capacity;
+} WorkDeque;
+
+// Per-thread scratch, never shared.
+typedef struct {
+    OperationNode nodes[MAX_OPERATIONS];
+    PropagationContext propagation;
+    CriticalPath critical;
+    SequenceGraph schedule;
+    MachineSequences sequences;
+    int critical_arcs[MAX_OPERATIONS];
+    int pending_preds[MAX_OPERATIONS];
+    int ready_time[MAX_OPERATIONS];
+    int ready[MAX_OPERATIONS];
+} Workspace;
+
+typedef struct {
+    const JSSPData* data;
+    const BranchBoundParams* params;
+    int num_threads;
+    WorkDeque deques[MAX_SEARCH_THREADS];
+
+    _Atomic int incumbent;
+    pthread_mutex_t best_lock;
+    int best_makespan;          // Makespan of best, guarded by best_lock
+    MachineSequences best;
+
+    _Atomic long long pending;  // Nodes pushed but not yet expanded; 0 at the end means proven
+    _Atomic bool stop;
+    _Atomic long long nodes;
+    _Atomic long long pruned;
+    _Atomic long long steals;
+    _Atomic int root_bound;
+    struct timespec start;
+
+    // Every open node is queued or being expanded. Workers hold the read side while a
+    // node moves between the two or is freed, the checkpoint thread the write side
+    // while it copies the frontier.
+    pthread_rwlock_t frontier_lock;
+    SearchNode* expanding[MAX_SEARCH_THREADS];
+} Search;
+
+typedef struct {
+    Search* search;
+    int id;
+    Workspace* workspace;
+} SearchWorker;
+
+static double seconds_since(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+static void deque_push(WorkDeque* dq, SearchNode* node) {
+    pthread_mutex_lock(&dq->lock);
+    if (dq->tail == dq->capacity) {
+        if (dq->head > 0) {
+            memmove(dq->items, dq->items + dq->head, (dq->tail - dq->head) * sizeof(SearchNode*));
+            dq->tail -= dq->head;
+            dq->head = 0;
+        }
+        if (dq->tail == dq->capacity) {
+            dq->capacity *= 2;
+            dq->items = realloc(dq->items, dq->capacity * sizeof(SearchNode*));
+        }
+    }
+    dq->items[dq->tail++] = node;
+    pthread_mutex_unlock(&dq->lock);
+}
+
+static SearchNode* deque_pop(WorkDeque* dq) {
+    SearchNode* node = NULL;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->tail > dq->head) {
+        node = dq->items[--dq->tail];
+        if (dq->tail == dq->head) dq->head = dq->tail = 0;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return node;
+}
+
+static SearchNode* deque_steal(WorkDeque* dq) {
+    SearchNode* node = NULL;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->tail > dq->head) {
+        node = dq->items[dq->head++];
+        if (dq->tail == dq->head) dq->head = dq->tail = 0;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return node;
+}
+
+static SearchNode* make_node(const int (*arcs)[2], int num_arcs, int from, int to) {
+    SearchNode* node = malloc(sizeof(SearchNode));
+    node->num_arcs = num_arcs + 1;
+    node->arcs = malloc(node->num_arcs * sizeof(*node->arcs));
+    memcpy(node->arcs, arcs, num_arcs * sizeof(*node->arcs));
+    node->arcs[num_arcs][0] = from;
+    node->arcs[num_arcs][1] = to;
+    return node;
+}
+
+static void free_node(SearchNode* node) {
+    free(node->arcs);
+    free(node);
+}
+
+static void append_frontier_node(SearchFrontier* frontier, const SearchNode* node) {
+    if (frontier->num_nodes == frontier->node_capacity) {
+        frontier->node_capacity = frontier->node_capacity > 0 ? 2 * frontier->node_capacity : INITIAL_DEQUE_CAPACITY;
+        frontier->num_arcs = realloc(frontier->num_arcs, frontier->node_capacity * sizeof(int));
+    }
+    if (frontier->total_arcs + node->num_arcs > frontier->arc_capacity) {
+        frontier->arc_capacity = 2 * (frontier->total_arcs + node->num_arcs);
+        frontier->arcs = realloc(frontier->arcs, frontier->arc_capacity * sizeof(*frontier->arcs));
+    }
+    frontier->num_arcs[frontier->num_nodes++] = node->num_arcs;
+    memcpy(frontier->arcs + frontier->total_arcs, node->arcs, node->num_arcs * sizeof(*node->arcs));
+    frontier->total_arcs += node->num_arcs;
+}
+
+static void offer_incumbent(Search* search, const MachineSequences* seq, int makespan) {
+    int current = atomic_load(&search->incumbent);
+    while (makespan < current && !atomic_compare_exchange_weak(&search->incumbent, &current, makespan)) {
+    }
+    if (makespan >= current) return;
+
+    pthread_mutex_lock(&search->best_lock);
+    if (makespan < search->best_makespan) {
+        search->best_makespan = makespan;
+        search->best = *seq;
+    }
+    pthread_mutex_unlock(&search->best_lock);
+}
+
+/**
+ * Builds a complete orientation that keeps every arc of the node: operations are
+ * dispatched once all their graph predecessors are done, earliest start first,
+ * largest tail on ties.
+ */
+static void dispatch_schedule(Workspace* ws, int num_operations, int num_machines, const int* tail) {
+    int machine_ready[MAX_MACHINES] = { 0 };
+    int num_ready = 0;
+
+    ws->sequences.num_jobs = num_operations / num_machines;
+    ws->sequences.num_machines = num_machines;
+    for (int m = 0; m < num_machines; m++) {
+        ws->sequences.length[m] = 0;
+    }
+    for (int x = 0; x < num_operations; x++) {
+        ws->pending_preds[x] = ws->nodes[x].num_predecessors;
+        ws->ready_time[x] = 0;
+        if (ws->pending_preds[x] == 0) ws->ready[num_ready++] = x;
+    }
+
+    while (num_ready > 0) {
+        int pick = 0, pick_start = INT_MAX;
+        for (int r = 0; r < num_ready; r++) {
+            int x = ws->ready[r];
+            int start = ws->ready_time[x] > machine_ready[ws->nodes[x].machine] ? ws->ready_time[x] : machine_ready[ws->nodes[x].machine];
+            if (start < pick_start || (start == pick_start && tail[x] > tail[ws->ready[pick]])) {
+                pick = r;
+                pick_start = start;
+            }
+        }
+
+        int x = ws->ready[pick];
+        ws->ready[pick] = ws->ready[--num_ready];
+
+        OperationNode* node = &ws->nodes[x];
+        int finish = pick_start + node->duration;
+        machine_ready[node->machine] = finish;
+        ws->sequences.order[node->machine][ws->sequences.length[node->machine]++] = x;
+
+        for (int s = 0; s < node->num_successors; s++) {
+            int y = node->successors[s];
+            if (finish > ws->ready_time[y]) ws->ready_time[y] = finish;
+            if (--ws->pending_preds[y] == 0) ws->ready[num_ready++] = y;
+        }
+    }
+}
+
+// Picks an undecided critical arc, preferring the first or last arc of a block.
+static int choose_branch_arc(Workspace* ws, int num_arcs) {
+    const SequenceGraph* g = &ws->schedule;
+    int fallback = -1;
+
+    for (int i = 0; i < num_arcs; i++) {
+        int u = ws->critical_arcs[i];
+        int v = g->machine_next[u];
+        if (disjunction_state(ws->nodes, u, v) != DISJ_UNDECIDED) continue;
+
+        bool starts_block = true, ends_block = true;
+        for (int k = 0; k < num_arcs; k++) {
+            if (g->machine_next[ws->critical_arcs[k]] == u) starts_block = false;
+            if (ws->critical_arcs[k] == v) ends_block = false;
+        }
+        if (starts_block || ends_block) return i;
+        if (fallback < 0) fallback = i;
+    }
+    return fallback;
+}
+
+static void expand_node(Search* search, SearchWorker* worker, SearchNode* node) {
+    Workspace* ws = worker->workspace;
+    const JSSPData* data = search->data;
+    int num_machines = data->num_machines;
+    int num_operations = data->num_jobs * num_machines;
+    bool is_root = node->num_arcs == 0;
+
+    build_disjunctive_graph(data, ws->nodes, num_operations);
+    for (int a = 0; a < node->num_arcs; a++) {
+        add_successor_unique(&ws->nodes[node->arcs[a][0]], node->arcs[a][1]);
+        add_predecessor_unique(&ws->nodes[node->arcs[a][1]], node->arcs[a][0]);
+    }
+
+    // Only strictly better solutions matter below this node
+    int upper_bound = atomic_load(&search->incumbent);
+    init_propagation(&ws->propagation, num_operations, num_machines, upper_bound - 1);
+    if (propagate_disjunctions(&ws->propagation, ws->nodes, num_operations) == PROPAGATION_INFEASIBLE) {
+        if (is_root) atomic_store(&search->root_bound, upper_bound);
+        atomic_fetch_add(&search->pruned, 1);
+        return;
+    }
+
+    const CriticalPath* cp = get_critical_path(&ws->critical, ws->nodes, num_operations);
+    if (cp == NULL) {
+        atomic_fetch_add(&search->pruned, 1);
+        return;
+    }
+
+    int lower_bound = cp->makespan;
+    for (int m = 0; m < num_machines; m++) {
+        MachineOps* machine = &ws->propagation.sets.machines[m];
+        int bound = one_machine_preemptive_bound(ws->nodes, machine->op_indices, machine->num_ops, cp->head, cp->tail);
+        if (bound > lower_bound) lower_bound = bound;
+    }
+    if (is_root) atomic_store(&search->root_bound, lower_bound);
+    if (lower_bound >= atomic_load(&search->incumbent)) {
+        atomic_fetch_add(&search->pruned, 1);
+        return;
+    }
+
+    dispatch_schedule(ws, num_operations, num_machines, cp->tail);
+    int makespan = load_sequence_graph(&ws->schedule, data, &ws->sequences);
+    offer_incumbent(search, &ws->sequences, makespan);
+    if (lower_bound >= makespan) return;  // The node's own schedule is optimal for it
+
+    int num_arcs = critical_machine_arcs(&ws->schedule, ws->critical_arcs, MAX_OPERATIONS);
+    int branch = choose_branch_arc(ws, num_arcs);
+    if (branch < 0) return;  // Critical path fully fixed: nothing below beats this schedule
+
+    // Children inherit everything propagation fixed here
+    int fixed_count = 0;
+    for (int x = 0; x < num_operations; x++) {
+        for (int s = 0; s < ws->nodes[x].num_successors; s++) {
+            if (ws->nodes[ws->nodes[x].successors[s]].machine == ws->nodes[x].machine) fixed_count++;
+        }
+    }
+    int (*fixed)[2] = malloc((fixed_count + 1) * sizeof(*fixed));
+    int k = 0;
+    for (int x = 0; x < num_operations; x++) {
+        for (int s = 0; s < ws->nodes[x].num_successors; s++) {
+            int y = ws->nodes[x].successors[s];
+            if (ws->nodes[y].machine == ws->nodes[x].machine) {
+                fixed[k][0] = x;
+                fixed[k][1] = y;
+                k++;
+            }
+        }
+    }
+
+    int u = ws->critical_arcs[branch];
+    int v = ws->schedule.machine_next[u];
+    atomic_fetch_add(&search->pending, 2);
+    deque_push(&search->deques[worker->id], make_node((const int (*)[2])fixed, fixed_count, u, v));
+    deque_push(&search->deques[worker->id], make_node((const int (*)[2])fixed, fixed_count, v, u));  // Reversal first
+    free(fixed);
+}
+
+static void* search_worker(void* arg) {
+    SearchWorker* worker = arg;
+    Search* search = worker->search;
+
+    // On a stop the remaining nodes stay queued, so the final checkpoint still holds them
+    while (!atomic_load(&search->stop)) {
+        pthread_rwlock_rdlock(&search->frontier_lock);
+        SearchNode* node = deque_pop(&search->deques[worker->id]);
+        for (int k = 1; node == NULL && k < search->num_threads; k++) {
+            node = deque_steal(&search->deques[(worker->id + k) % search->num_threads]);
+            if (node != NULL) atomic_fetch_add(&search->steals, 1);
+        }
+        search->expanding[worker->id] = node;
+        pthread_rwlock_unlock(&search->frontier_lock);
+
+        if (node == NULL) {
+            if (atomic_load(&search->pending) == 0) break;
+            sched_yield();
+            continue;
+        }
+
+        expand_node(search, worker, node);
+        atomic_fetch_add(&search->nodes, 1);
+
+        // The children are queued by now
+        pthread_rwlock_rdlock(&search->frontier_lock);
+        search->expanding[worker->id] = NULL;
+        free_node(node);
+        pthread_rwlock_unlock(&search->frontier_lock);
+        long long open = atomic_fetch_sub(&search->pending, 1) - 1;
+
+        // Running out of time after the last open node still completes the proof
+        if (open > 0 && search->params->seconds > 0 && seconds_since(&search->start) >= search->params->seconds) {
+            atomic_store(&search->stop, true);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Checkpoint callback: copies the queued and the expanding nodes. A node whose children
+ * are already queued may be copied along with them; resuming then explores that subtree
+ * twice, which costs time but loses nothing.
+ */
+static int capture_search(void* solver, Checkpoint* checkpoint) {
+    Search* search = solver;
+    SearchFrontier* frontier = &checkpoint->frontier;
+
+    frontier->num_nodes = 0;
+    frontier->total_arcs = 0;
+    pthread_rwlock_wrlock(&search->frontier_lock);
+    for (int t = 0; t < search->num_threads; t++) {
+        WorkDeque* dq = &search->deques[t];
+        pthread_mutex_lock(&dq->lock);
+        for (int i = dq->head; i < dq->tail; i++) {
+            append_frontier_node(frontier, dq->items[i]);
+        }
+        pthread_mutex_unlock(&dq->lock);
+        if (search->expanding[t] != NULL) append_frontier_node(frontier, search->expanding[t]);
+    }
+    frontier->nodes = atomic_load(&search->nodes);
+    frontier->pruned = atomic_load(&search->pruned);
+    frontier->steals = atomic_load(&search->steals);
+    frontier->root_bound = atomic_load(&search->root_bound);
+    frontier->elapsed = seconds_since(&search->start);
+
+    pthread_mutex_lock(&search->best_lock);
+    checkpoint->best_makespan = search->best.num_jobs > 0 ? search->best_makespan : -1;
+    checkpoint->best = search->best;
+    pthread_mutex_unlock(&search->best_lock);
+    pthread_rwlock_unlock(&search->frontier_lock);
+
+    checkpoint->phase = CHECKPOINT_EXACT;
+    return 0;
+}
+
+/**
+ * Proves optimality (or improves the incumbent within the time budget).
+ * @param data JSSP instance
+ * @param incumbent Starting orientation, or NULL
+ * @param incumbent_makespan Its makespan, used as the initial upper bound (-1 if none)
+ * @param params Thread count, time budget, checkpoints, frontier to resume
+ * @param best Output: best orientation found
+ * @param stats Output: search counters (may be NULL)
+ * @return best makespan
+ */
+int branch_and_bound(const JSSPData* data, const MachineSequences* incumbent, int incumbent_makespan,
+    const BranchBoundParams* params, MachineSequences* best, BranchBoundStats* stats) {
+    Search* search = calloc(1, sizeof(Search));
+    search->data = data;
+    search->params = params;
+    search->num_threads = params->num_threads > 0 ? params->num_threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (search->num_threads < 1) search->num_threads = 1;
+    if (search->num_threads > MAX_SEARCH_THREADS) search->num_threads = MAX_SEARCH_THREADS;
+
+    // Without a starting solution any semi-active schedule beats the total work
+    if (incumbent == NULL || incumbent_makespan < 0) {
+        incumbent_makespan = 1;
+        for (int j = 0; j < data->num_jobs; j++) {
+            for (int o = 0; o < data->num_machines; o++) {
+                incumbent_makespan += data->operations[j][o].duration;
+            }
+        }
+    }
+    else {
+        search->best = *incumbent;
+    }
+    atomic_init(&search->incumbent, incumbent_makespan);
+    atomic_init(&search->root_bound, 0);
+    search->best_makespan = incumbent_makespan;
+    pthread_mutex_init(&search->best_lock, NULL);
+    pthread_rwlock_init(&search->frontier_lock, NULL);
+
+    for (int t = 0; t < search->num_threads; t++) {
+        WorkDeque* dq = &search->deques[t];
+        pthread_mutex_init(&dq->lock, NULL);
+        dq->capacity = INITIAL_DEQUE_CAPACITY;
+        dq->items = malloc(dq->capacity * sizeof(SearchNode*));
+        dq->head = dq->tail = 0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &search->start);
+
+    const SearchFrontier* resume = params->resume;
+    if (resume != NULL) {
+        // Deal the open nodes out round robin; the budget covers the time already spent
+        const int (*arcs)[2] = (const int (*)[2])resume->arcs;
+        for (int n = 0; n < resume->num_nodes; n++) {
+            SearchNode* node = malloc(sizeof(SearchNode));
+            node->num_arcs = resume->num_arcs[n];
+            node->arcs = malloc((node->num_arcs > 0 ? node->num_arcs : 1) * sizeof(*node->arcs));
+            memcpy(node->arcs, arcs, node->num_arcs * sizeof(*node->arcs));
+            arcs += node->num_arcs;
+            deque_push(&search->deques[n % search->num_threads], node);
+        }
+        atomic_init(&search->pending, resume->num_nodes);
+        atomic_init(&search->nodes, resume->nodes);
+        atomic_init(&search->pruned, resume->pruned);
+        atomic_init(&search->steals, resume->steals);
+        atomic_store(&search->root_bound, resume->root_bound);
+
+        search->start.tv_sec -= (time_t)resume->elapsed;
+        search->start.tv_nsec -= (long)((resume->elapsed - (time_t)resume->elapsed) * 1e9);
+        if (search->start.tv_nsec < 0) {
+            search->start.tv_sec--;
+            search->start.tv_nsec += 1000000000L;
+        }
+    }
+    else {
+        SearchNode* root = malloc(sizeof(SearchNode));
+        root->num_arcs = 0;
+        root->arcs = NULL;
+        atomic_init(&search->pending, 1);
+        deque_push(&search->deques[0], root);
+    }
+
+    Checkpointer checkpointer;
+    bool checkpointing = params->checkpoint_path != NULL
+        && start_checkpointer(&checkpointer, params->checkpoint_path, params->checkpoint_interval,
+            data, capture_search, search) == 0;
+
+    pthread_t threads[MAX_SEARCH_THREADS];
+    SearchWorker workers[MAX_SEARCH_THREADS];
+    for (int t = 0; t < search->num_threads; t++) {
+        workers[t].search = search;
+        workers[t].id = t;
+        workers[t].workspace = calloc(1, sizeof(Workspace));  // Zeroed: no cached critical path yet
+        pthread_create(&threads[t], NULL, search_worker, &workers[t]);
+    }
+    for (int t = 0; t < search->num_threads; t++) {
+        pthread_join(threads[t], NULL);
+        free(workers[t].workspace);
+    }
+    if (checkpointing) stop_checkpointer(&checkpointer, true);
+
+    *best = search->best;
+    int result = search->best_makespan;
+
+    if (stats != NULL) {
+        stats->num_threads = search->num_threads;
+        stats->best_makespan = result;
+        stats->root_bound = atomic_load(&search->root_bound);
+        stats->proven_optimal = atomic_load(&search->pending) == 0;     // An exhausted tree is a proof, timed out or not
+        stats->nodes = atomic_load(&search->nodes);
+        stats->pruned = atomic_load(&search->pruned);
+        stats->steals = atomic_load(&search->steals);
+        stats->elapsed = seconds_since(&search->start);
+    }
+
+    for (int t = 0; t < search->num_threads; t++) {
+        WorkDeque* dq = &search->deques[t];
+        for (int i = dq->head; i < dq->tail; i++) {
+            free_node(dq->items[i]);
+        }
+        pthread_mutex_destroy(&dq->lock);
+        free(dq->items);
+    }
+    pthread_mutex_destroy(&search->best_lock);
+    pthread_rwlock_destroy(&search->frontier_lock);
+    free(search);
+    return result;
+}
+
+void print_branch_bound_stats(const BranchBoundStats* stats) {
+    if (stats->proven_optimal) {
+        printf("Branch and bound: optimum %d proven", stats->best_makespan);
+    }
+    else {
+        printf("Branch and bound: stopped, best %d, root bound %d", stats->best_makespan, stats->root_bound);
+    }
+    printf(" (%d threads, %.2f s)\n", stats->num_threads, stats->elapsed);
+    printf("  Nodes: %lld expanded, %lld pruned, %lld stolen\n", stats->nodes, stats->pruned, stats->steals);
+}
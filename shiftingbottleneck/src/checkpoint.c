@@ -0,0 +1,408 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "checkpoint.h"
+#include "store.h"
+
+#define CHECKPOINT_MAGIC 0x54504b43u       // "CKPT"
+#define CHECKPOINT_VERSION 1
+#define CHECKPOINT_PATH_LEN 512
+
+#define FNV_OFFSET 14695981039346656037ull
+#define FNV_PRIME 1099511628211ull
+
+// Fixed part of a checkpoint file, followed by payload_size bytes of payload.
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t hash;              // hash_jssp_data of the instance
+    int32_t phase;
+    int32_t num_jobs;
+    int32_t num_machines;
+    int32_t best_makespan;
+    uint64_t payload_size;
+    uint64_t checksum;          // FNV-1a over the payload
+} CheckpointHeader;
+
+typedef struct {
+    unsigned char* bytes;
+    size_t size;
+    size_t capacity;
+} Buffer;
+
+typedef struct {
+    const unsigned char* bytes;
+    size_t size;
+    size_t pos;
+    bool failed;                // Set by the first read past the end or of an invalid value
+} Reader;
+
+static uint64_t fnv1a(uint64_t hash, const void* bytes, size_t size) {
+    const unsigned char* p = bytes;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static void put(Buffer* b, const void* data, size_t size) {
+    if (b->size + size > b->capacity) {
+        b->capacity = b->capacity > 0 ? b->capacity : 4096;
+        while (b->size + size > b->capacity) b->capacity *= 2;
+        b->bytes = realloc(b->bytes, b->capacity);
+    }
+    memcpy(b->bytes + b->size, data, size);
+    b->size += size;
+}
+
+static void put_i32(Buffer* b, int32_t v) { put(b, &v, sizeof(v)); }
+static void put_i64(Buffer* b, int64_t v) { put(b, &v, sizeof(v)); }
+static void put_u64(Buffer* b, uint64_t v) { put(b, &v, sizeof(v)); }
+static void put_double(Buffer* b, double v) { put(b, &v, sizeof(v)); }
+
+// Per machine: length, then the operations in order.
+static void put_sequences(Buffer* b, const MachineSequences* seq) {
+    for (int m = 0; m < seq->num_machines; m++) {
+        put_i32(b, seq->length[m]);
+        for (int i = 0; i < seq->length[m]; i++) put_i32(b, seq->order[m][i]);
+    }
+}
+
+static void get(Reader* r, void* data, size_t size) {
+    if (r->failed || r->size - r->pos < size) {
+        r->failed = true;
+        memset(data, 0, size);
+        return;
+    }
+    memcpy(data, r->bytes + r->pos, size);
+    r->pos += size;
+}
+
+static int32_t get_i32(Reader* r) { int32_t v; get(r, &v, sizeof(v)); return v; }
+static int64_t get_i64(Reader* r) { int64_t v; get(r, &v, sizeof(v)); return v; }
+static uint64_t get_u64(Reader* r) { uint64_t v; get(r, &v, sizeof(v)); return v; }
+static double get_double(Reader* r) { double v; get(r, &v, sizeof(v)); return v; }
+
+// Reads a value that must lie in [lo, hi]; anything else marks the file as invalid.
+static int get_bounded(Reader* r, int lo, int hi) {
+    int32_t v = get_i32(r);
+    if (v < lo || v > hi) {
+        r->failed = true;
+        return lo;
+    }
+    return v;
+}
+
+static void get_sequences(Reader* r, const JSSPData* data, MachineSequences* seq) {
+    int num_operations = data->num_jobs * data->num_machines;
+    seq->num_jobs = data->num_jobs;
+    seq->num_machines = data->num_machines;
+    for (int m = 0; m < data->num_machines; m++) {
+        seq->length[m] = get_bounded(r, 0, data->num_jobs);
+        for (int i = 0; i < seq->length[m]; i++) seq->order[m][i] = get_bounded(r, 0, num_operations - 1);
+    }
+}
+
+static void put_tempering(Buffer* b, const TemperingState* state) {
+    put_i32(b, state->num_replicas);
+    put_i32(b, state->round);
+    put_u64(b, state->exchange_rng);
+    put_i64(b, state->exchanges_proposed);
+    put_i64(b, state->exchanges_accepted);
+    put_double(b, state->elapsed);
+    for (int k = 0; k < state->num_replicas; k++) {
+        put_double(b, state->temperature[k]);
+        put_i32(b, state->replica_at_level[k]);
+    }
+    for (int i = 0; i < state->num_replicas; i++) {
+        const ReplicaState* replica = &state->replicas[i];
+        put_sequences(b, &replica->current);
+        put_sequences(b, &replica->best);
+        put_i32(b, replica->best_makespan);
+        put_u64(b, replica->rng);
+        put_i64(b, replica->moves);
+        put_i64(b, replica->accepted);
+    }
+}
+
+static void get_tempering(Reader* r, const JSSPData* data, TemperingState* state) {
+    state->num_replicas = get_bounded(r, 1, MAX_REPLICAS);
+    state->round = get_i32(r);
+    state->exchange_rng = get_u64(r);
+    state->exchanges_proposed = get_i64(r);
+    state->exchanges_accepted = get_i64(r);
+    state->elapsed = get_double(r);
+    for (int k = 0; k < state->num_replicas; k++) {
+        state->temperature[k] = get_double(r);
+        state->replica_at_level[k] = get_bounded(r, 0, state->num_replicas - 1);
+    }
+    for (int i = 0; i < state->num_replicas; i++) {
+        ReplicaState* replica = &state->replicas[i];
+        get_sequences(r, data, &replica->current);
+        get_sequences(r, data, &replica->best);
+        replica->best_makespan = get_i32(r);
+        replica->rng = get_u64(r);
+        replica->moves = get_i64(r);
+        replica->accepted = get_i64(r);
+    }
+}
+
+static void put_frontier(Buffer* b, const SearchFrontier* frontier) {
+    put_double(b, frontier->elapsed);
+    put_i64(b, frontier->nodes);
+    put_i64(b, frontier->pruned);
+    put_i64(b, frontier->steals);
+    put_i32(b, frontier->root_bound);
+    put_i32(b, frontier->num_nodes);
+    int (*arcs)[2] = frontier->arcs;
+    for (int n = 0; n < frontier->num_nodes; n++) {
+        put_i32(b, frontier->num_arcs[n]);
+        for (int a = 0; a < frontier->num_arcs[n]; a++, arcs++) {
+            put_i32(b, (*arcs)[0]);
+            put_i32(b, (*arcs)[1]);
+        }
+    }
+}
+
+static void get_frontier(Reader* r, const JSSPData* data, SearchFrontier* frontier) {
+    int num_operations = data->num_jobs * data->num_machines;
+    memset(frontier, 0, sizeof(*frontier));
+    frontier->elapsed = get_double(r);
+    frontier->nodes = get_i64(r);
+    frontier->pruned = get_i64(r);
+    frontier->steals = get_i64(r);
+    frontier->root_bound = get_i32(r);
+    frontier->num_nodes = get_bounded(r, 0, INT32_MAX);
+
+    // Every node takes at least 4 bytes and every arc 8, which bounds what a damaged file
+    // can make us allocate
+    if ((size_t)frontier->num_nodes > (r->size - r->pos) / sizeof(int32_t)) r->failed = true;
+    if (r->failed) {
+        frontier->num_nodes = 0;
+        return;
+    }
+    size_t max_arcs = (r->size - r->pos) / (2 * sizeof(int32_t));
+    frontier->node_capacity = frontier->num_nodes > 0 ? frontier->num_nodes : 1;
+    frontier->num_arcs = malloc(frontier->node_capacity * sizeof(int));
+    for (int n = 0; n < frontier->num_nodes && !r->failed; n++) {
+        frontier->num_arcs[n] = get_bounded(r, 0, num_operations * MAX_OPS_PER_MACHINE);
+        if (frontier->total_arcs + frontier->num_arcs[n] > (long long)max_arcs) {
+            r->failed = true;
+            break;
+        }
+        if (frontier->total_arcs + frontier->num_arcs[n] > frontier->arc_capacity) {
+            frontier->arc_capacity = 2 * (frontier->total_arcs + frontier->num_arcs[n]);
+            frontier->arcs = realloc(frontier->arcs, frontier->arc_capacity * sizeof(*frontier->arcs));
+        }
+        for (int a = 0; a < frontier->num_arcs[n]; a++) {
+            frontier->arcs[frontier->total_arcs][0] = get_bounded(r, 0, num_operations - 1);
+            frontier->arcs[frontier->total_arcs][1] = get_bounded(r, 0, num_operations - 1);
+            frontier->total_arcs++;
+        }
+    }
+}
+
+/**
+ * Writes a checkpoint atomically: to path.tmp first, synced, then renamed over path.
+ * @param path Checkpoint file
+ * @param data JSSP instance the checkpoint belongs to
+ * @param checkpoint Captured state
+ * @return 0 on success, -1 on error
+ */
+int write_checkpoint(const char* path, const JSSPData* data, const Checkpoint* checkpoint) {
+    char tmp_path[CHECKPOINT_PATH_LEN];
+    Buffer payload = { 0 };
+
+    if (snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path) >= (int)sizeof(tmp_path)) {
+        fprintf(stderr, "Checkpoint: path too long: %s\n", path);
+        return -1;
+    }
+
+    if (checkpoint->best_makespan >= 0) put_sequences(&payload, &checkpoint->best);
+    if (checkpoint->phase == CHECKPOINT_ANNEAL) put_tempering(&payload, checkpoint->tempering);
+    else put_frontier(&payload, &checkpoint->frontier);
+
+    CheckpointHeader header = {
+        .magic = CHECKPOINT_MAGIC,
+        .version = CHECKPOINT_VERSION,
+        .hash = hash_jssp_data(data),
+        .phase = checkpoint->phase,
+        .num_jobs = data->num_jobs,
+        .num_machines = data->num_machines,
+        .best_makespan = checkpoint->best_makespan,
+        .payload_size = payload.size,
+        .checksum = fnv1a(FNV_OFFSET, payload.bytes, payload.size),
+    };
+
+    int status = -1;
+    int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        bool ok = write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header)
+            && write(fd, payload.bytes, payload.size) == (ssize_t)payload.size
+            && fsync(fd) == 0;
+        close(fd);
+        if (ok && rename(tmp_path, path) == 0) status = 0;
+        else unlink(tmp_path);
+    }
+    if (status != 0) fprintf(stderr, "Checkpoint: cannot write %s\n", path);
+    free(payload.bytes);
+    return status;
+}
+
+/**
+ * Reads a checkpoint written for the same instance.
+ * @param path Checkpoint file
+ * @param data JSSP instance
+ * @param checkpoint Output; release with free_checkpoint
+ * @return 0 on success, -1 on error
+ */
+int read_checkpoint(const char* path, const JSSPData* data, Checkpoint* checkpoint) {
+    CheckpointHeader header;
+    struct stat st;
+
+    memset(checkpoint, 0, sizeof(*checkpoint));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Checkpoint: cannot open %s\n", path);
+        return -1;
+    }
+    if (fstat(fd, &st) != 0 || read(fd, &header, sizeof(header)) != (ssize_t)sizeof(header)
+        || header.magic != CHECKPOINT_MAGIC || header.version != CHECKPOINT_VERSION
+        || header.payload_size != (uint64_t)st.st_size - sizeof(header)) {
+        fprintf(stderr, "Checkpoint: %s is not a checkpoint file\n", path);
+        close(fd);
+        return -1;
+    }
+    if (header.hash != hash_jssp_data(data) || header.num_jobs != data->num_jobs
+        || header.num_machines != data->num_machines) {
+        fprintf(stderr, "Checkpoint: %s was written for another instance\n", path);
+        close(fd);
+        return -1;
+    }
+
+    unsigned char* payload = malloc(header.payload_size > 0 ? header.payload_size : 1);
+    bool complete = read(fd, payload, header.payload_size) == (ssize_t)header.payload_size;
+    close(fd);
+    if (!complete || fnv1a(FNV_OFFSET, payload, header.payload_size) != header.checksum) {
+        fprintf(stderr, "Checkpoint: %s is damaged\n", path);
+        free(payload);
+        return -1;
+    }
+
+    Reader r = { payload, header.payload_size, 0, false };
+    checkpoint->phase = header.phase;
+    checkpoint->best_makespan = header.best_makespan;
+    if (header.best_makespan >= 0) get_sequences(&r, data, &checkpoint->best);
+    if (header.phase == CHECKPOINT_ANNEAL) {
+        checkpoint->tempering = malloc(sizeof(TemperingState));
+        get_tempering(&r, data, checkpoint->tempering);
+    }
+    else if (header.phase == CHECKPOINT_EXACT) {
+        get_frontier(&r, data, &checkpoint->frontier);
+    }
+    else {
+        r.failed = true;
+    }
+    free(payload);
+
+    if (r.failed || r.pos != r.size) {
+        fprintf(stderr, "Checkpoint: %s is damaged\n", path);
+        free_checkpoint(checkpoint);
+        return -1;
+    }
+    return 0;
+}
+
+void free_checkpoint(Checkpoint* checkpoint) {
+    free(checkpoint->tempering);
+    free(checkpoint->frontier.num_arcs);
+    free(checkpoint->frontier.arcs);
+    checkpoint->tempering = NULL;
+    checkpoint->frontier.num_arcs = NULL;
+    checkpoint->frontier.arcs = NULL;
+}
+
+static void capture_and_write(Checkpointer* ck) {
+    if (ck->capture(ck->solver, &ck->snapshot) == 0 && write_checkpoint(ck->path, ck->data, &ck->snapshot) == 0) {
+        ck->num_written++;
+    }
+}
+
+static void* checkpoint_thread(void* arg) {
+    Checkpointer* ck = arg;
+
+    pthread_mutex_lock(&ck->lock);
+    while (!ck->stop) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += (time_t)ck->interval;
+        deadline.tv_nsec += (long)((ck->interval - (time_t)ck->interval) * 1e9);
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        while (!ck->stop && pthread_cond_timedwait(&ck->wake, &ck->lock, &deadline) != ETIMEDOUT) {
+        }
+        if (ck->stop) break;
+
+        // The solver keeps running while the snapshot goes to disk
+        pthread_mutex_unlock(&ck->lock);
+        capture_and_write(ck);
+        pthread_mutex_lock(&ck->lock);
+    }
+    pthread_mutex_unlock(&ck->lock);
+    return NULL;
+}
+
+/**
+ * Starts writing periodic checkpoints of a solver.
+ * @param ck Checkpointer to initialize
+ * @param path Checkpoint file, replaced by every snapshot
+ * @param interval Seconds between two snapshots (<= 0 for the default)
+ * @param data JSSP instance being solved
+ * @param capture Copies the solver's state, called from the checkpoint thread
+ * @param solver Passed to capture
+ * @return 0 on success, -1 if the thread could not be started
+ */
+int start_checkpointer(Checkpointer* ck, const char* path, double interval, const JSSPData* data,
+    CaptureCheckpoint capture, void* solver) {
+    memset(ck, 0, sizeof(*ck));
+    ck->path = path;
+    ck->interval = interval > 0.0 ? interval : CHECKPOINT_DEFAULT_INTERVAL;
+    ck->data = data;
+    ck->capture = capture;
+    ck->solver = solver;
+    ck->snapshot.best_makespan = -1;
+    pthread_mutex_init(&ck->lock, NULL);
+    pthread_cond_init(&ck->wake, NULL);
+
+    if (pthread_create(&ck->thread, NULL, checkpoint_thread, ck) != 0) {
+        fprintf(stderr, "Checkpoint: cannot start the checkpoint thread\n");
+        pthread_mutex_destroy(&ck->lock);
+        pthread_cond_destroy(&ck->wake);
+        return -1;
+    }
+    return 0;
+}
+
+void stop_checkpointer(Checkpointer* ck, bool final) {
+    pthread_mutex_lock(&ck->lock);
+    ck->stop = true;
+    pthread_cond_signal(&ck->wake);
+    pthread_mutex_unlock(&ck->lock);
+    pthread_join(ck->thread, NULL);
+
+    if (final) capture_and_write(ck);
+
+    pthread_mutex_destroy(&ck->lock);
+    pthread_cond_destroy(&ck->wake);
+    free_checkpoint(&ck->snapshot);
+}
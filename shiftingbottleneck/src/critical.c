@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "critical.h"
+
+void invalidate_critical_path(CriticalPath* cp) {
+    cp->valid = false;
+}
+
+// Forward pass: heads and longest-path predecessors in topological order.
+static bool forward_pass(CriticalPath* cp, const OperationNode* nodes, int num_operations) {
+    int in_degree[MAX_OPERATIONS];
+    int front = 0, rear = 0;
+
+    for (int i = 0; i < num_operations; i++) {
+        in_degree[i] = nodes[i].num_predecessors;
+        cp->head[i] = 0;
+        cp->longest_pred[i] = -1;
+        if (in_degree[i] == 0) {
+            cp->order[rear++] = i;
+        }
+    }
+
+    while (front < rear) {
+        int u = cp->order[front++];
+        int finish = cp->head[u] + nodes[u].duration;
+        for (int s = 0; s < nodes[u].num_successors; s++) {
+            int v = nodes[u].successors[s];
+            if (finish > cp->head[v] || cp->longest_pred[v] < 0) {
+                cp->head[v] = finish;
+                cp->longest_pred[v] = u;
+            }
+            if (--in_degree[v] == 0) {
+                cp->order[rear++] = v;
+            }
+        }
+    }
+
+    return rear == num_operations;
+}
+
+// Backward pass: tails, makespan and slack over the reversed order.
+static void backward_pass(CriticalPath* cp, const OperationNode* nodes, int num_operations) {
+    cp->makespan = 0;
+    for (int k = num_operations - 1; k >= 0; k--) {
+        int u = cp->order[k];
+        cp->tail[u] = 0;
+        for (int s = 0; s < nodes[u].num_successors; s++) {
+            int v = nodes[u].successors[s];
+            int length = nodes[v].duration + cp->tail[v];
+            if (length > cp->tail[u]) {
+                cp->tail[u] = length;
+            }
+        }
+        int total = cp->head[u] + nodes[u].duration + cp->tail[u];
+        if (total > cp->makespan) {
+            cp->makespan = total;
+        }
+    }
+
+    for (int i = 0; i < num_operations; i++) {
+        cp->slack[i] = cp->makespan - cp->head[i] - nodes[i].duration - cp->tail[i];
+    }
+}
+
+// Walks longest_pred back from the op that finishes last and splits the path into machine blocks.
+static void extract_path(CriticalPath* cp, const OperationNode* nodes, int num_operations) {
+    int sink = -1;
+    for (int i = 0; i < num_operations; i++) {
+        if (cp->head[i] + nodes[i].duration == cp->makespan) {
+            sink = i;
+            break;
+        }
+    }
+
+    cp->path_length = 0;
+    cp->num_blocks = 0;
+    if (sink < 0) return;
+
+    for (int v = sink; v >= 0; v = cp->longest_pred[v]) {
+        cp->path[cp->path_length++] = v;
+    }
+    for (int i = 0, j = cp->path_length - 1; i < j; i++, j--) {
+        int tmp = cp->path[i]; cp->path[i] = cp->path[j]; cp->path[j] = tmp;
+    }
+
+    for (int i = 0; i < cp->path_length; i++) {
+        int machine = nodes[cp->path[i]].machine;
+        if (cp->num_blocks > 0 && cp->blocks[cp->num_blocks - 1].machine == machine) {
+            cp->blocks[cp->num_blocks - 1].length++;
+        }
+        else {
+            CriticalBlock* b = &cp->blocks[cp->num_blocks++];
+            b->machine = machine;
+            b->first = i;
+            b->length = 1;
+        }
+    }
+}
+
+/**
+ * Returns the critical path, its machine blocks and per-operation slack.
+ * The result is cached in cp and reused while the graph keeps its largest node stamp
+ * (every change to arcs or durations moves it, see touch_node) and size.
+ * @param cp Cache, zero-initialize or invalidate before first use
+ * @param nodes Global array of OperationNode
+ * @param num_operations Number of nodes
+ * @return cp, or NULL if the graph contains a cycle
+ */
+const CriticalPath* get_critical_path(CriticalPath* cp, const OperationNode* nodes, int num_operations) {
+    unsigned long version = 0;
+    for (int i = 0; i < num_operations; i++) {
+        if (nodes[i].version > version) version = nodes[i].version;
+    }
+    if (cp->valid && cp->nodes == nodes && cp->num_operations == num_operations && cp->version == version) {
+        return cp;
+    }
+
+    cp->valid = false;
+    if (!forward_pass(cp, nodes, num_operations)) {
+        return NULL;
+    }
+    backward_pass(cp, nodes, num_operations);
+    extract_path(cp, nodes, num_operations);
+
+    cp->nodes = nodes;
+    cp->num_operations = num_operations;
+    cp->version = version;
+    cp->valid = true;
+    return cp;
+}
+
+void print_critical_path(const CriticalPath* cp, const OperationNode* nodes, int num_machines) {
+    int critical_time[MAX_MACHINES] = { 0 };
+
+    printf("\n=== Critical Path (makespan %d, %d ops, %d blocks) ===\n", cp->makespan, cp->path_length, cp->num_blocks);
+    for (int b = 0; b < cp->num_blocks; b++) {
+        const CriticalBlock* block = &cp->blocks[b];
+        printf("Block %d on Machine %d:", b, block->machine);
+        for (int i = block->first; i < block->first + block->length; i++) {
+            int op = cp->path[i];
+            printf(" %d(J%d,O%d,%d-%d)", op, nodes[op].job_id, nodes[op].op_index,
+                cp->head[op], cp->head[op] + nodes[op].duration);
+            critical_time[block->machine] += nodes[op].duration;
+        }
+        printf("\n");
+    }
+
+    // Share of the makespan each machine spends on the critical path
+    printf("Critical time per machine:");
+    for (int m = 0; m < num_machines; m++) {
+        if (critical_time[m] > 0) {
+            printf(" M%d=%d (%.1f%%)", m, critical_time[m], 100.0 * critical_time[m] / cp->makespan);
+        }
+    }
+    printf("\n");
+}
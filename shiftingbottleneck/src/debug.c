@@ -3,11 +3,7 @@
 int** load_and_print_jssp_matrix(const char* jss_filename, int* num_jobs, int* num_machines, int* optimum_value) {
     int** matrix = load_jssp_matrix(jss_filename, num_jobs, num_machines, optimum_value);
 
-    if (*num_jobs > MAX_JOBS) {
-        fprintf(stderr, "Error: Number of jobs exceeds the maximum allowed (%d). Found %d jobs.\n", MAX_JOBS, *num_jobs);
-        exit(1);
-    }
-
+    // More than MAX_JOBS jobs is fine: main hands such instances to the rolling horizon
     if (*num_machines > MAX_MACHINES) {
         fprintf(stderr, "Error: Number of machines exceeds the maximum allowed (%d). Found %d machines.\n", MAX_MACHINES, *num_machines);
         exit(1);
@@ -126,23 +122,19 @@ void print_disjunctive_graph(OperationNode* nodes, int num_operations) {
     }
 }
 
-void print_disjunctive_candidates(const GraphData* data) {
-    printf("GraphData: %d arcs\n", data->num_arcs);
-    for (int i = 0; i < data->num_arcs; ++i) {
-        printf("  Arc %3d: from %d to %d\n", i, data->arcs[i].from, data->arcs[i].to);
-    }
-    /**
-     * Detect if the arcs really come in pairs (bidirectional).
-     * Detect duplicates.
-     * Print total distinct edges (half of arcs).
-     */
-    for (int i = 0; i < data->num_arcs; i += 2) {
-        int from1 = data->arcs[i].from;
-        int to1 = data->arcs[i].to;
-        int from2 = data->arcs[i + 1].from;
-        int to2 = data->arcs[i + 1].to;
-        if (!(from1 == to2 && to1 == from2)) {
-            printf("WARNING: arcs %d and %d are not symmetric!\n", i, i + 1);
+void print_disjunctive_candidates(const DisjunctiveSets* sets, OperationNode* nodes) {
+    static const char* state_names[] = { "undecided", "->", "<-" };
+
+    printf("Disjunctions: %d undecided\n", count_undecided_disjunctions(sets, nodes));
+    for (int m = 0; m < sets->num_machines; ++m) {
+        const MachineOps* machine = &sets->machines[m];
+        printf("Machine %d (%d ops%s):\n", m, machine->num_ops, machine->sequenced ? ", sequenced" : "");
+
+        DisjunctionIterator it;
+        int first, second;
+        init_disjunction_iterator(&it, sets, m);
+        while (next_disjunction(sets, &it, &first, &second)) {
+            printf("  %d %s %d\n", first, state_names[disjunction_state(nodes, first, second)], second);
         }
     }
 }
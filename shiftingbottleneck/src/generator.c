@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "generator.h"
+#include "file_utils.h"
+
+#define BOTTLENECK_SHARE 10     // One machine in ten is a bottleneck
+#define BOTTLENECK_FACTOR 2
+#define FLOW_SHOP_SWAP_SHARE 5  // m / 5 adjacent swaps per job
+
+/**
+ * Taillard's portable uniform generator (Lehmer, a = 16807, m = 2^31 - 1, Schrage's trick).
+ * Kept bit-for-bit so that published seeds reproduce the published instances.
+ * @param seed In/out generator state
+ * @param low Smallest value returned
+ * @param high Largest value returned
+ * @return a value uniformly drawn from [low, high]
+ */
+static int taillard_unif(long* seed, int low, int high) {
+    static const long m = 2147483647, a = 16807, b = 127773, c = 2836;
+    long k = *seed / b;
+    *seed = a * (*seed % b) - k * c;
+    if (*seed < 0) *seed = *seed + m;
+    double value_0_1 = *seed / (double)m;
+    return low + (int)(value_0_1 * (high - low + 1));  // Truncation is floor here, the value is non-negative
+}
+
+static void generate_routing(const GeneratorParams* params, long* machine_seed, int* routing) {
+    int m = params->num_machines;
+    for (int j = 0; j < m; j++) {
+        routing[j] = j;
+    }
+
+    if (params->kind == GEN_FLOW_SHOP) {
+        for (int s = 0; s < m / FLOW_SHOP_SWAP_SHARE; s++) {
+            int pos = taillard_unif(machine_seed, 0, m - 2);
+            int tmp = routing[pos]; routing[pos] = routing[pos + 1]; routing[pos + 1] = tmp;
+        }
+        return;
+    }
+
+    for (int j = 0; j < m; j++) {
+        int other = taillard_unif(machine_seed, j, m - 1);
+        int tmp = routing[j]; routing[j] = routing[other]; routing[other] = tmp;
+    }
+}
+
+/**
+ * Generates a random instance.
+ * Durations are drawn first for every job/operation from the time seed, routings
+ * afterwards from the machine seed, as in Taillard's benchmark generator.
+ * @param params Instance shape, duration range, seeds and variant
+ * @return matrix of num_jobs rows and 2 * num_machines columns, or NULL on bad parameters
+ */
+int** generate_jssp_matrix(const GeneratorParams* params) {
+    int n = params->num_jobs;
+    int m = params->num_machines;
+    if (n <= 0 || m <= 0 || params->min_duration < 1 || params->max_duration < params->min_duration) {
+        fprintf(stderr, "Error: invalid generator parameters (%d jobs, %d machines, durations %d..%d)\n",
+            n, m, params->min_duration, params->max_duration);
+        return NULL;
+    }
+    if (m < 2 && params->kind == GEN_FLOW_SHOP) {
+        fprintf(stderr, "Error: flow-shop variant needs at least 2 machines\n");
+        return NULL;
+    }
+
+    long time_seed = params->time_seed;
+    long machine_seed = params->machine_seed;
+
+    int** matrix = malloc(n * sizeof(int*));
+    for (int i = 0; i < n; i++) {
+        matrix[i] = malloc(2 * m * sizeof(int));
+        for (int j = 0; j < m; j++) {
+            matrix[i][2 * j + 1] = taillard_unif(&time_seed, params->min_duration, params->max_duration);
+        }
+    }
+
+    int* routing = malloc(m * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        generate_routing(params, &machine_seed, routing);
+        for (int j = 0; j < m; j++) {
+            matrix[i][2 * j] = routing[j];
+        }
+    }
+
+    if (params->kind == GEN_BOTTLENECK) {
+        // Pick the bottleneck machines as the head of a random machine permutation
+        for (int j = 0; j < m; j++) {
+            routing[j] = j;
+        }
+        int num_bottlenecks = m / BOTTLENECK_SHARE > 0 ? m / BOTTLENECK_SHARE : 1;
+        for (int j = 0; j < num_bottlenecks; j++) {
+            int other = taillard_unif(&machine_seed, j, m - 1);
+            int tmp = routing[j]; routing[j] = routing[other]; routing[other] = tmp;
+        }
+
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < m; j++) {
+                for (int b = 0; b < num_bottlenecks; b++) {
+                    if (matrix[i][2 * j] == routing[b]) {
+                        matrix[i][2 * j + 1] *= BOTTLENECK_FACTOR;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    free(routing);
+    return matrix;
+}
+
+int generate_jssp_data(const GeneratorParams* params, JSSPData* data) {
+    if (params->num_jobs > MAX_JOBS || params->num_machines > MAX_MACHINES) {
+        fprintf(stderr, "Error: generated instance %dx%d exceeds MAX_JOBS/MAX_MACHINES (%d/%d)\n",
+            params->num_jobs, params->num_machines, MAX_JOBS, MAX_MACHINES);
+        return -1;
+    }
+
+    int** matrix = generate_jssp_matrix(params);
+    if (matrix == NULL) return -1;
+
+    initialize_schedule_data(matrix, params->num_jobs, params->num_machines, data);
+    free_matrix(matrix, params->num_jobs);
+    return 0;
+}
+
+/**
+ * Writes a JSSP matrix in the .jss text format.
+ * @param path Destination file
+ * @param matrix Matrix as returned by load_jssp_matrix or generate_jssp_matrix
+ * @param num_jobs Number of rows
+ * @param num_machines Number of machine/duration pairs per row
+ * @return 0 on success, -1 on I/O error
+ */
+int write_jssp_file(const char* path, int** matrix, int num_jobs, int num_machines) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "Could not open %s for writing\n", path);
+        return -1;
+    }
+
+    fprintf(file, "%d %d\n", num_jobs, num_machines);
+    for (int i = 0; i < num_jobs; i++) {
+        for (int j = 0; j < num_machines; j++) {
+            fprintf(file, "%s%d %d", j == 0 ? "" : " ", matrix[i][2 * j], matrix[i][2 * j + 1]);
+        }
+        fprintf(file, "\n");
+    }
+
+    if (fclose(file) != 0) {
+        fprintf(stderr, "Error writing %s\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+void format_generated_filename(char* out, size_t len, const GeneratorParams* params) {
+    snprintf(out, len, "%s%dx%d_%s_%ld_%ld.jss", GENERATED_SUBDIR,
+        params->num_jobs, params->num_machines, generator_kind_name(params->kind),
+        params->time_seed, params->machine_seed);
+}
+
+const char* generator_kind_name(GeneratorKind kind) {
+    switch (kind) {
+    case GEN_TAILLARD: return "ta";
+    case GEN_FLOW_SHOP: return "fs";
+    case GEN_BOTTLENECK: return "bn";
+    }
+    return "??";
+}
+
+int parse_generator_kind(const char* name, GeneratorKind* kind) {
+    if (strcmp(name, "ta") == 0 || strcmp(name, "taillard") == 0) *kind = GEN_TAILLARD;
+    else if (strcmp(name, "fs") == 0 || strcmp(name, "flowshop") == 0) *kind = GEN_FLOW_SHOP;
+    else if (strcmp(name, "bn") == 0 || strcmp(name, "bottleneck") == 0) *kind = GEN_BOTTLENECK;
+    else return -1;
+    return 0;
+}
@@ -0,0 +1,282 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <time.h>
+
+#include "horizon.h"
+#include "main.h"
+#include "sequence.h"
+
+#define MAX_DESCENT_ROUNDS 10000
+
+// Jobs of the current window and what has been frozen so far.
+typedef struct {
+    int num_machines;
+    int active[MAX_JOBS];           // Window job -> instance job
+    int num_active;
+    int* next_op;                   // Per instance job: first operation not yet committed
+    int* job_ready;                 // Per instance job: end of its last committed operation
+    int machine_ready[MAX_MACHINES];
+} HorizonState;
+
+static double seconds_since(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+// Committed operations of unfinished jobs stay in the window as zero-length placeholders.
+static inline bool is_placeholder(const HorizonState* state, int x) {
+    return x % state->num_machines < state->next_op[state->active[x / state->num_machines]];
+}
+
+// Moves the placeholders to the front of every machine so they never delay anything.
+static void placeholders_first(const HorizonState* state, MachineSequences* seq) {
+    int rest[MAX_OPS_PER_MACHINE];
+    for (int m = 0; m < seq->num_machines; m++) {
+        int front = 0, num_rest = 0;
+        for (int i = 0; i < seq->length[m]; i++) {
+            int x = seq->order[m][i];
+            if (is_placeholder(state, x)) seq->order[m][front++] = x;
+            else rest[num_rest++] = x;
+        }
+        for (int i = 0; i < num_rest; i++) seq->order[m][front + i] = rest[i];
+    }
+}
+
+// Release-aware dispatch, the rule of greedy_upper_bound started from the committed
+// times: always append the operation that can start first. Acyclic by construction.
+static void dispatch_sequences(const JSSPData* window, const HorizonState* state, MachineSequences* seq) {
+    int next_op[MAX_JOBS];
+    int job_ready[MAX_JOBS];
+    int machine_ready[MAX_MACHINES];
+    int remaining = 0;
+
+    seq->num_jobs = window->num_jobs;
+    seq->num_machines = window->num_machines;
+    for (int m = 0; m < window->num_machines; m++) {
+        seq->length[m] = 0;
+        machine_ready[m] = state->machine_ready[m];
+    }
+    for (int k = 0; k < window->num_jobs; k++) {
+        int job = state->active[k];
+        next_op[k] = state->next_op[job];
+        job_ready[k] = state->job_ready[job];
+        remaining += window->num_machines - next_op[k];
+        // Placeholders lead their machines, see placeholders_first
+        for (int o = 0; o < next_op[k]; o++) {
+            int m = window->operations[k][o].machine;
+            seq->order[m][seq->length[m]++] = op_node_index(k, window->num_machines, o);
+        }
+    }
+
+    for (; remaining > 0; remaining--) {
+        int best = -1, best_start = INT_MAX, best_duration = INT_MAX;
+        for (int k = 0; k < window->num_jobs; k++) {
+            if (next_op[k] >= window->num_machines) continue;
+            Task t = window->operations[k][next_op[k]];
+            int start = job_ready[k] > machine_ready[t.machine] ? job_ready[k] : machine_ready[t.machine];
+            if (start < best_start || (start == best_start && t.duration < best_duration)) {
+                best = k;
+                best_start = start;
+                best_duration = t.duration;
+            }
+        }
+
+        Task t = window->operations[best][next_op[best]];
+        seq->order[t.machine][seq->length[t.machine]++] = op_node_index(best, window->num_machines, next_op[best]);
+        next_op[best]++;
+        job_ready[best] = best_start + t.duration;
+        machine_ready[t.machine] = job_ready[best];
+    }
+}
+
+// Loads a window's orientation behind the committed machine and job times.
+// Returns the makespan, -1 on a cycle.
+static int load_window(SequenceGraph* g, const JSSPData* window, const MachineSequences* seq, const HorizonState* state) {
+    if (load_sequence_graph(g, window, seq) < 0) return -1;
+    for (int x = 0; x < g->num_operations; x++) {
+        if (is_placeholder(state, x)) continue;
+        int job = state->active[x / state->num_machines];
+        g->release[x] = state->machine_ready[g->machine_of[x]];
+        if (x % state->num_machines == state->next_op[job] && state->job_ready[job] > g->release[x]) {
+            g->release[x] = state->job_ready[job];
+        }
+    }
+    return evaluate_sequence_graph(g);
+}
+
+static long long total_completion(const SequenceGraph* g) {
+    long long total = 0;
+    for (int x = 0; x < g->num_operations; x++) total += g->head[x] + g->duration[x];
+    return total;
+}
+
+// First-improvement descent over critical-arc swaps. Returns the swaps kept.
+static long long improve_window(SequenceGraph* g) {
+    int arcs[MAX_OPERATIONS];
+    long long accepted = 0;
+
+    for (int round = 0; round < MAX_DESCENT_ROUNDS; round++) {
+        bool improved = false;
+        int num_arcs = critical_machine_arcs(g, arcs, MAX_OPERATIONS);
+        for (int i = 0; i < num_arcs && !improved; i++) {
+            int before = g->makespan;
+            int after = swap_adjacent(g, arcs[i]);
+            if (after < 0) continue;
+            if (after < before) {
+                improved = true;
+                accepted++;
+            }
+            else {
+                revert_swap(g);
+            }
+        }
+        if (!improved) break;
+    }
+    return accepted;
+}
+
+/**
+ * Freezes every operation of the window that starts before cut and drops finished jobs.
+ * Committed operations form a prefix of each job and of each machine order.
+ */
+static void commit_window(const SequenceGraph* g, HorizonState* state, int cut, int** starts) {
+    int num_machines = state->num_machines;
+    int kept = 0;
+
+    for (int k = 0; k < state->num_active; k++) {
+        int job = state->active[k];
+        while (state->next_op[job] < num_machines) {
+            int x = op_node_index(k, num_machines, state->next_op[job]);
+            if (g->head[x] >= cut) break;
+
+            int end = g->head[x] + g->duration[x];
+            starts[job][state->next_op[job]] = g->head[x];
+            state->job_ready[job] = end;
+            if (end > state->machine_ready[g->machine_of[x]]) state->machine_ready[g->machine_of[x]] = end;
+            state->next_op[job]++;
+        }
+        if (state->next_op[job] < num_machines) state->active[kept++] = job;
+    }
+    state->num_active = kept;
+}
+
+/**
+ * Schedules an arbitrarily large instance window by window.
+ * @param matrix Instance in loader layout
+ * @param num_jobs Rows of matrix
+ * @param num_machines Operations per job
+ * @param params Window size and committed share
+ * @param start_times Output: newly allocated num_jobs x num_machines start times
+ * @param stats Output: window count, makespan, time (may be NULL)
+ * @return makespan, or -1 on invalid parameters
+ */
+int rolling_horizon(int** matrix, int num_jobs, int num_machines, const HorizonParams* params,
+    int*** start_times, HorizonStats* stats) {
+    if (num_machines < 1 || num_machines > MAX_MACHINES) {
+        fprintf(stderr, "Rolling horizon needs 1..%d machines, got %d\n", MAX_MACHINES, num_machines);
+        return -1;
+    }
+    if (params->window_jobs < 1 || params->window_jobs > MAX_JOBS
+        || params->commit_fraction <= 0.0 || params->commit_fraction > 1.0) {
+        fprintf(stderr, "Rolling horizon needs 1 <= window <= %d and a commit fraction in (0, 1]\n", MAX_JOBS);
+        return -1;
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    int** starts = malloc(num_jobs * sizeof(int*));
+    for (int j = 0; j < num_jobs; j++) {
+        starts[j] = malloc(num_machines * sizeof(int));
+    }
+
+    HorizonState* state = calloc(1, sizeof(HorizonState));
+    state->num_machines = num_machines;
+    state->next_op = calloc(num_jobs, sizeof(int));
+    state->job_ready = calloc(num_jobs, sizeof(int));
+
+    JSSPData* window = malloc(sizeof(JSSPData));
+    Schedule* sched = malloc(sizeof(Schedule));
+    MachineSequences* seq = malloc(sizeof(MachineSequences));
+    SequenceGraph* g = malloc(sizeof(SequenceGraph));
+    int num_windows = 0;
+    long long swaps_accepted = 0;
+
+    bool trace = shifting_bottleneck_trace;
+    shifting_bottleneck_trace = false;
+
+    for (int next_job = 0; state->num_active > 0 || next_job < num_jobs; num_windows++) {
+        while (state->num_active < params->window_jobs && next_job < num_jobs) {
+            state->active[state->num_active++] = next_job++;
+        }
+
+        window->num_jobs = state->num_active;
+        window->num_machines = num_machines;
+        for (int k = 0; k < state->num_active; k++) {
+            int job = state->active[k];
+            for (int o = 0; o < num_machines; o++) {
+                window->operations[k][o].machine = matrix[job][2 * o];
+                window->operations[k][o].duration = o < state->next_op[job] ? 0 : matrix[job][2 * o + 1];
+            }
+        }
+
+        // SBP sees neither the committed times nor the placeholders' history, so its
+        // orientation can lose to plain dispatch. Only the early part of the window is
+        // committed, so compare total completion time rather than the window's makespan.
+        dispatch_sequences(window, state, seq);
+        load_window(g, window, seq, state);
+        long long dispatched = total_completion(g);
+        compute_shifting_bottleneck(window, sched);
+        extract_machine_sequences(sched, window, seq);
+        placeholders_first(state, seq);
+        if (load_window(g, window, seq, state) < 0 || total_completion(g) > dispatched) {
+            dispatch_sequences(window, state, seq);
+            load_window(g, window, seq, state);
+        }
+        swaps_accepted += improve_window(g);
+
+        // The last window takes everything; otherwise freeze the first share of its span
+        int cut = INT_MAX;
+        if (next_job < num_jobs) {
+            int earliest = INT_MAX;
+            for (int x = 0; x < g->num_operations; x++) {
+                if (!is_placeholder(state, x) && g->head[x] < earliest) earliest = g->head[x];
+            }
+            cut = earliest + (int)((g->makespan - earliest) * params->commit_fraction);
+            if (cut <= earliest) cut = earliest + 1;
+        }
+        commit_window(g, state, cut, starts);
+    }
+
+    shifting_bottleneck_trace = trace;
+
+    int makespan = 0;
+    for (int m = 0; m < num_machines; m++) {
+        if (state->machine_ready[m] > makespan) makespan = state->machine_ready[m];
+    }
+
+    free(window);
+    free(sched);
+    free(seq);
+    free(g);
+    free(state->next_op);
+    free(state->job_ready);
+    free(state);
+
+    *start_times = starts;
+    if (stats != NULL) {
+        stats->num_windows = num_windows;
+        stats->makespan = makespan;
+        stats->swaps_accepted = swaps_accepted;
+        stats->elapsed = seconds_since(&start);
+    }
+    return makespan;
+}
+
+void print_horizon_stats(const HorizonStats* stats) {
+    printf("Rolling horizon: %d windows, makespan %d, %.3f s\n", stats->num_windows, stats->makespan, stats->elapsed);
+    printf("  Improving swaps: %lld\n", stats->swaps_accepted);
+}
@@ -7,8 +7,26 @@
 #include "file_utils.h"
 #include "debug.h"
 #include "ssms.h"
+#include "propagate.h"
+#include "generator.h"
+#include "verify.h"
+#include "critical.h"
+#include "sequence.h"
+#include "anneal.h"
+#include "memetic.h"
+#include "bnb.h"
+#include "bench.h"
+#include "reschedule.h"
+#include "horizon.h"
+#include "store.h"
+#include "checkpoint.h"
 #include "main.h"
 
+bool shifting_bottleneck_trace = true;
+
+// Per thread: graphs are only changed and cached by the thread that owns them
+static _Thread_local unsigned long node_clock = 0;
+
 void initialize_schedule_data(int** matrix, int num_jobs, int num_machines, JSSPData* data) {
     data->num_jobs = num_jobs;
     data->num_machines = num_machines;
@@ -49,22 +67,27 @@ bool has_predecessor(OperationNode* node, int pred_id) {
     return false;
 }
 
+void touch_node(OperationNode* node) {
+    node->version = ++node_clock;
+}
+
+// Self-loops are rejected by assert_valid_edge at the call sites: a node does not know its own index.
 void add_successor_unique(OperationNode* node, int succ_id) {
-    if (succ_id == op_node_index(node->job_id, node->op_index, MAX_MACHINES)) return;
     if (!has_successor(node, succ_id)) {
         node->successors[node->num_successors++] = succ_id;
+        touch_node(node);
     }
 }
 
 void add_predecessor_unique(OperationNode* node, int pred_id) {
-    if (pred_id == op_node_index(node->job_id, node->op_index, MAX_MACHINES)) return;
     if (!has_predecessor(node, pred_id)) {
         node->predecessors[node->num_predecessors++] = pred_id;
+        touch_node(node);
     }
 }
 
 // This does not and should not contemplate the disjunctive edges from the beggining.
-void build_disjunctive_graph(JSSPData* data, OperationNode* nodes, int num_operations) {
+void build_disjunctive_graph(const JSSPData* data, OperationNode* nodes, int num_operations) {
     int num_jobs = data->num_jobs;
     int num_machines = data->num_machines;
 
@@ -84,6 +107,7 @@ void build_disjunctive_graph(JSSPData* data, OperationNode* nodes, int num_opera
 
             nodes[idx].earliest_start = 0;
             nodes[idx].latest_finish = 0;
+            touch_node(&nodes[idx]);
 
             // printf("%d\t%d\t%d\t%d\t\t%d\n", job, op, t.machine, t.duration, idx); //DEBUG <- all goo so far
         }
@@ -147,61 +171,76 @@ int find_bottleneck_machine(JSSPData* data, bool machine_scheduled[MAX_MACHINES]
     return bottleneck;
 }
 
-int count_operations_on_bottleneck_machine(OperationNode* nodes, int num_operations, int bottleneck_machine, int* ops_on_machine) {
-    int count = 0;
+/**
+ * Groups the operations by machine. The lists have O(ops) size and are rebuilt
+ * from scratch, so calling this again never accumulates candidates.
+ * @param nodes Global array of OperationNode
+ * @param num_operations Number of nodes
+ * @param num_machines Number of machines in the instance
+ * @param sets Output: one operation list per machine, all unsequenced
+ */
+void build_machine_ops(const OperationNode* nodes, int num_operations, int num_machines, DisjunctiveSets* sets) {
+    sets->num_machines = num_machines;
+    for (int m = 0; m < num_machines; m++) {
+        sets->machines[m].machine_id = m;
+        sets->machines[m].num_ops = 0;
+        sets->machines[m].sequenced = false;
+    }
+
     for (int i = 0; i < num_operations; i++) {
-        if (nodes[i].machine == bottleneck_machine) {
-            ops_on_machine[count++] = i;
+        MachineOps* machine = &sets->machines[nodes[i].machine];
+        if (machine->num_ops >= MAX_OPS_PER_MACHINE) {
+            printf("Warning: more than %d operations on machine %d!\n", MAX_OPS_PER_MACHINE, machine->machine_id);
+            continue;
         }
+        machine->op_indices[machine->num_ops++] = i;
     }
-    return count;
 }
 
-void add_disjunctive_arc(GraphData* graph, int from, int to) {
-    if (graph->num_arcs >= MAX_DISJ_ARCS) {
-        // Optional: handle overflow
-        return;
-    }
-
-    graph->arcs[graph->num_arcs].from = from;
-    graph->arcs[graph->num_arcs].to = to;
-    graph->num_arcs++;
+DisjunctionState disjunction_state(OperationNode* nodes, int first, int second) {
+    if (has_successor(&nodes[first], second)) return DISJ_FORWARD;
+    if (has_successor(&nodes[second], first)) return DISJ_BACKWARD;
+    return DISJ_UNDECIDED;
 }
 
-void store_disjunctive_candidates(OperationNode* nodes, int total_operations, GraphData* data) {
-    static int machine_buckets[MAX_MACHINES][MAX_OPS_PER_MACHINE];
-    static int bucket_sizes[MAX_MACHINES];
-    // Reset bucket sizes
-    for (int m = 0; m < MAX_MACHINES; m++) {
-        bucket_sizes[m] = 0;
-    }
+// machine < 0 iterates the pairs of every machine.
+void init_disjunction_iterator(DisjunctionIterator* it, const DisjunctiveSets* sets, int machine) {
+    it->machine = machine < 0 ? 0 : machine;
+    it->last_machine = machine < 0 ? sets->num_machines - 1 : machine;
+    it->i = 0;
+    it->j = 1;
+}
 
-    // Fill machine buckets
-    for (int i = 0; i < total_operations; i++) {
-        int machine = nodes[i].machine;
-        int index = bucket_sizes[machine]++;
-        machine_buckets[machine][index] = i;
+bool next_disjunction(const DisjunctiveSets* sets, DisjunctionIterator* it, int* first, int* second) {
+    while (it->machine <= it->last_machine) {
+        const MachineOps* machine = &sets->machines[it->machine];
+        if (it->j >= machine->num_ops) {
+            it->i++;
+            it->j = it->i + 1;
+        }
+        if (it->j < machine->num_ops) {
+            *first = machine->op_indices[it->i];
+            *second = machine->op_indices[it->j];
+            it->j++;
+            return true;
+        }
+        it->machine++;
+        it->i = 0;
+        it->j = 1;
     }
+    return false;
+}
 
-    // Store disjunctive arcs for each machine
-    for (int m = 0; m < MAX_MACHINES; m++) {
-        int size = bucket_sizes[m];
-
-        for (int i = 0; i < size - 1; i++) {
-            for (int j = i + 1; j < size; j++) {
-                int op_i = machine_buckets[m][i];
-                int op_j = machine_buckets[m][j];
-
-                add_disjunctive_arc(data, op_i, op_j);
-                add_disjunctive_arc(data, op_j, op_i);
-            }
-        }
+int count_undecided_disjunctions(const DisjunctiveSets* sets, OperationNode* nodes) {
+    DisjunctionIterator it;
+    int first, second, count = 0;
 
-        if (data->num_arcs >= MAX_DISJ_ARCS) {
-            printf("Warning: graph arcs overflow!\n");
-            return;
-        }
+    init_disjunction_iterator(&it, sets, -1);
+    while (next_disjunction(sets, &it, &first, &second)) {
+        if (disjunction_state(nodes, first, second) == DISJ_UNDECIDED)
+            count++;
     }
+    return count;
 }
 
 void orient_disjunctive_arcs(OperationNode* nodes,
@@ -215,11 +254,13 @@ void orient_disjunctive_arcs(OperationNode* nodes,
         int from = ops_on_machine[best_sequence[i]];
         int to = ops_on_machine[best_sequence[i + 1]];
 
-        printf("best_sequence: ");
-        for (int i = 0; i < num_ops; ++i) printf("%d ", best_sequence[i]);
-        printf("\nops_on_machine: ");
-        for (int i = 0; i < num_ops; ++i) printf("%d ", ops_on_machine[i]);
-        printf("\n");
+        if (shifting_bottleneck_trace) {
+            printf("best_sequence: ");
+            for (int i = 0; i < num_ops; ++i) printf("%d ", best_sequence[i]);
+            printf("\nops_on_machine: ");
+            for (int i = 0; i < num_ops; ++i) printf("%d ", ops_on_machine[i]);
+            printf("\n");
+        }
 
         assert_valid_edge(from, to);
 
@@ -275,6 +316,8 @@ void fill_schedule_from_nodes(Schedule* sched, OperationNode* nodes, JSSPData* d
     // Clear existing schedule times
     memset(sched->start_time, 0, sizeof(sched->start_time));
     memset(sched->end_time, 0, sizeof(sched->end_time));
+    memset(sched->job_ready, 0, sizeof(sched->job_ready));
+    memset(sched->machine_ready, 0, sizeof(sched->machine_ready));
 
     for (int i = 0; i < num_jobs * num_machines; i++) {
         OperationNode* op = &nodes[i];
@@ -287,7 +330,7 @@ void fill_schedule_from_nodes(Schedule* sched, OperationNode* nodes, JSSPData* d
         sched->start_time[job][op_idx] = start;
         sched->end_time[job][op_idx] = end;
 
-        // Optional: update ready times if wanted (not strictly necessary here)
+        // Ready times are checked against the end times by verify_schedule
         if (sched->job_ready[job] < end) {
             sched->job_ready[job] = end;
         }
@@ -307,47 +350,82 @@ void compute_shifting_bottleneck(JSSPData* data, Schedule* sched) {
     bool machine_scheduled[MAX_MACHINES] = { false };
     build_disjunctive_graph(data, nodes, num_operations);
 
-    print_disjunctive_graph(nodes, num_operations); // DEBUG
+    if (shifting_bottleneck_trace) print_disjunctive_graph(nodes, num_operations); // DEBUG
 
-    for (int scheduled = 0; scheduled < num_machines; scheduled++) {
-        static GraphData graph = { .num_arcs = 0 };
+    static CriticalPath critical;
+
+    static DisjunctiveSets disjunctions;
+    build_machine_ops(nodes, num_operations, num_machines, &disjunctions);
+
+    // Fix the disjunctions implied by a dispatching bound before any subproblem is solved
+    static PropagationContext propagation;
+    init_propagation(&propagation, num_operations, num_machines, greedy_upper_bound(data));
+    bool propagation_enabled = true;
+
+    int settled = propagate_disjunctions(&propagation, nodes, num_operations);
+    if (settled == PROPAGATION_INFEASIBLE) {
+        if (shifting_bottleneck_trace) printf("Propagation: bound %d is infeasible, propagation disabled\n", propagation.upper_bound);
+        propagation_enabled = false;
+    }
+    else if (shifting_bottleneck_trace) {
+        printf("Propagation: bound %d fixed %d disjunctions\n", propagation.upper_bound, settled);
+    }
 
+    for (int scheduled = 0; scheduled < num_machines; scheduled++) {
         int bottleneck_machine = find_bottleneck_machine(data, machine_scheduled);
 
-        printf("Step %d: Bottleneck = Machine %d\n", scheduled, bottleneck_machine);
+        if (shifting_bottleneck_trace) printf("Step %d: Bottleneck = Machine %d\n", scheduled, bottleneck_machine);
 
-        // Extract ops on bottleneck machine
-        int ops_on_machine[MAX_OPERATIONS];
-        int num_ops = count_operations_on_bottleneck_machine(nodes, num_operations, bottleneck_machine, ops_on_machine);
+        // Ops on bottleneck machine
+        int* ops_on_machine = disjunctions.machines[bottleneck_machine].op_indices;
+        int num_ops = disjunctions.machines[bottleneck_machine].num_ops;
         if (num_ops == 0) {
-            printf("No operations on bottleneck machine %d\n", bottleneck_machine);
+            if (shifting_bottleneck_trace) printf("No operations on bottleneck machine %d\n", bottleneck_machine);
             continue;
         }
 
-        store_disjunctive_candidates(nodes, num_operations, &graph);
-
-        // print_disjunctive_candidates(&graph); // DEBUG
+        // print_disjunctive_candidates(&disjunctions, nodes); // DEBUG
 
         int best_sequence[num_ops];
         
-        int makespan = solve_single_machine_subproblem_bf(nodes, ops_on_machine, num_ops, best_sequence);
-
-        printf("Best sequence indices (local to ops_on_machine): ");
-        for (int i = 0; i < num_ops; ++i) {
-            printf("%d ", best_sequence[i]);
+        int makespan;
+        const CriticalPath* cp = get_critical_path(&critical, nodes, num_operations);
+        if (cp == NULL) {
+            // Cannot happen while every sequence honors the delayed precedences below
+            printf("Error: partial orientation contains a cycle before machine %d\n", bottleneck_machine);
+            break;
         }
-        printf("\n");
 
-        // To print the corresponding global node indices:
-        printf("Best sequence (global node indices): ");
-        for (int i = 0; i < num_ops; ++i) {
-            printf("%d ", ops_on_machine[best_sequence[i]]);
+        // Paths through the machines sequenced so far order some of this machine's operations
+        static DelayedPrecedences delays;
+        compute_delayed_precedences(nodes, cp->order, num_operations, ops_on_machine, num_ops, &delays);
+
+        if (num_ops > BF_MAX_OPS) {
+            makespan = solve_single_machine_subproblem_schrage(nodes, ops_on_machine, num_ops, cp->head, cp->tail, &delays, best_sequence);
+            makespan = improve_single_machine_sequence(nodes, ops_on_machine, num_ops, cp->head, cp->tail, &delays, best_sequence);
         }
-        printf("\n");
-        
-        printf("Best sequence makespan on machine %d: %d\n", bottleneck_machine, makespan);
+        else {
+            makespan = solve_single_machine_subproblem_bf(nodes, ops_on_machine, num_ops, &delays, best_sequence);
+        }
+
+        if (shifting_bottleneck_trace) {
+            printf("Best sequence indices (local to ops_on_machine): ");
+            for (int i = 0; i < num_ops; ++i) {
+                printf("%d ", best_sequence[i]);
+            }
+            printf("\n");
 
-        validate_best_sequence(best_sequence, num_ops, num_operations); // DEBUG
+            // To print the corresponding global node indices:
+            printf("Best sequence (global node indices): ");
+            for (int i = 0; i < num_ops; ++i) {
+                printf("%d ", ops_on_machine[best_sequence[i]]);
+            }
+            printf("\n");
+
+            printf("Best sequence makespan on machine %d: %d\n", bottleneck_machine, makespan);
+
+            validate_best_sequence(best_sequence, num_ops, num_operations); // DEBUG
+        }
 
         // print_machine_sequence(bottleneck_machine, best_sequence, num_ops);  // DEBUG
 
@@ -356,9 +434,22 @@ void compute_shifting_bottleneck(JSSPData* data, Schedule* sched) {
         orient_disjunctive_arcs(nodes, bottleneck_machine, num_operations, ops_on_machine, num_ops, best_sequence);
 
         machine_scheduled[bottleneck_machine] = true;
+        disjunctions.machines[bottleneck_machine].sequenced = true;
 
         compute_earliest_start_times(nodes, num_operations);
 
+        if (propagation_enabled) {
+            settled = propagate_disjunctions(&propagation, nodes, num_operations);
+            if (settled == PROPAGATION_INFEASIBLE) {
+                // The orientation chosen above already exceeds the bound
+                if (shifting_bottleneck_trace) printf("Propagation: bound %d no longer reachable, propagation disabled\n", propagation.upper_bound);
+                propagation_enabled = false;
+            }
+            else if (shifting_bottleneck_trace) {
+                printf("Propagation: fixed %d disjunctions (total %d)\n", settled, propagation.num_fixed);
+            }
+        }
+
         // for (int i = 0; i < num_operations; i++) {
         //     printf("Op %2d (J%d, M%d): EST = %d\n",
         //         i, nodes[i].job_id, nodes[i].machine, nodes[i].earliest_start);
@@ -366,18 +457,175 @@ void compute_shifting_bottleneck(JSSPData* data, Schedule* sched) {
 
     }
 
+    const CriticalPath* cp = get_critical_path(&critical, nodes, num_operations);
+    if (cp != NULL) {
+        if (shifting_bottleneck_trace) print_critical_path(cp, nodes, num_machines);
+    }
+    else if (shifting_bottleneck_trace) {
+        printf("Warning: orientation contains a cycle, no critical path\n");
+    }
+
     fill_schedule_from_nodes(sched, nodes, data);
 }
 
 
-int main() {
+// Usage: --generate <ta|fs|bn> <jobs> <machines> [time_seed] [machine_seed] [min_dur] [max_dur]
+static int generate_instance_file(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: --generate <ta|fs|bn> <jobs> <machines> [time_seed] [machine_seed] [min_dur] [max_dur]\n");
+        return EXIT_FAILURE;
+    }
+
+    GeneratorParams params = {
+        .kind = GEN_TAILLARD,
+        .num_jobs = atoi(argv[1]),
+        .num_machines = atoi(argv[2]),
+        .min_duration = argc > 5 ? atoi(argv[5]) : 1,
+        .max_duration = argc > 6 ? atoi(argv[6]) : 99,
+        .time_seed = argc > 3 ? atol(argv[3]) : 1,
+        .machine_seed = argc > 4 ? atol(argv[4]) : 1,
+    };
+    if (parse_generator_kind(argv[0], &params.kind) != 0) {
+        fprintf(stderr, "Unknown generator kind '%s'\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int** matrix = generate_jssp_matrix(&params);
+    if (matrix == NULL) return EXIT_FAILURE;
+
+    char filename[MAX_FILENAME_LEN];
+    char path[256];
+    format_generated_filename(filename, sizeof(filename), &params);
+    snprintf(path, sizeof(path), "%s%s/%s", JSSP_ROOT, GENERATED_SUBDIR, filename);
+
+    int status = write_jssp_file(path, matrix, params.num_jobs, params.num_machines);
+    free_matrix(matrix, params.num_jobs);
+    if (status != 0) return EXIT_FAILURE;
+
+    printf("Wrote %s\n", path);
+    return 0;
+}
+
+static int solve_rolling_horizon(int** matrix, int num_jobs, int num_machines, const HorizonParams* params) {
+    int** start_times = NULL;
+    HorizonStats stats;
+    int makespan = rolling_horizon(matrix, num_jobs, num_machines, params, &start_times, &stats);
+    if (makespan < 0) return EXIT_FAILURE;
+    print_horizon_stats(&stats);
+
+    VerificationReport report;
+    int violations = verify_start_times(matrix, start_times, num_jobs, num_machines, makespan, &report);
+    print_verification_report(&report);
+
+    free_matrix(start_times, num_jobs);
+    return violations == 0 ? 0 : EXIT_FAILURE;
+}
+
+static int schedule_makespan(const Schedule* sched, const JSSPData* data) {
+    int makespan = 0;
+    for (int m = 0; m < data->num_machines; m++) {
+        if (sched->machine_ready[m] > makespan) makespan = sched->machine_ready[m];
+    }
+    return makespan;
+}
+
+// Replaces sched by the stored best schedule of data when that one is shorter.
+static void seed_from_store(const SolutionStore* store, const JSSPData* data, Schedule* sched, StoredBounds* bounds) {
+    static MachineSequences stored;
+    static Schedule candidate;
+
+    if (lookup_best_solution(store, data, &stored, bounds) < 0) {
+        printf("Store: no solution for this instance yet\n");
+        return;
+    }
+    if (schedule_from_sequences(&stored, data, &candidate) != bounds->makespan) {
+        printf("Store: stored solution does not evaluate to makespan %d, ignored\n", bounds->makespan);
+        bounds->makespan = -1;
+        return;
+    }
+
+    int makespan = schedule_makespan(sched, data);
+    printf("Store: best known makespan %d, lower bound %d%s (this run's SBP: %d)\n", bounds->makespan,
+        bounds->lower_bound, bounds->proven_optimal ? ", optimal" : "", makespan);
+    if (bounds->makespan < makespan) *sched = candidate;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--generate") == 0) {
+        return generate_instance_file(argc - 2, argv + 2);
+    }
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        return run_benchmarks(argc - 2, argv + 2);
+    }
+
     const char* jss_filename = "ft03.jss";
+    double anneal_seconds = 0.0;
+    double exact_seconds = 0.0;
+    double memetic_seconds = 0.0;
+    const char* delta_filename = NULL;
+    const char* store_dir = NULL;
+    const char* checkpoint_filename = NULL;
+    const char* resume_filename = NULL;
+    double checkpoint_interval = CHECKPOINT_DEFAULT_INTERVAL;
+    HorizonParams horizon = { 0, HORIZON_DEFAULT_COMMIT };
+    int num_threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--anneal") == 0 && i + 1 < argc) {
+            anneal_seconds = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--exact") == 0 && i + 1 < argc) {
+            exact_seconds = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--memetic") == 0 && i + 1 < argc) {
+            memetic_seconds = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--reschedule") == 0 && i + 1 < argc) {
+            delta_filename = argv[++i];
+        }
+        else if (strcmp(argv[i], "--store") == 0 && i + 1 < argc) {
+            store_dir = argv[++i];
+        }
+        else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            checkpoint_filename = argv[++i];
+        }
+        else if (strcmp(argv[i], "--checkpoint-every") == 0 && i + 1 < argc) {
+            checkpoint_interval = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--resume") == 0 && i + 1 < argc) {
+            resume_filename = argv[++i];
+        }
+        else if (strcmp(argv[i], "--horizon") == 0 && i + 1 < argc) {
+            horizon.window_jobs = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--commit") == 0 && i + 1 < argc) {
+            horizon.commit_fraction = atof(argv[++i]);
+        }
+        else if (argv[i][0] != '-') {
+            jss_filename = argv[i];
+        }
+        else {
+            fprintf(stderr, "Usage: %s [instance.jss] [--anneal <seconds>] [--exact <seconds>] [--memetic <seconds>] [--threads <n>] [--reschedule <delta>] [--store <dir>] [--checkpoint <file> [--checkpoint-every <seconds>]] [--resume <file>] [--horizon <jobs> [--commit <fraction>]]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
 
     int num_jobs = 0, num_machines = 0, optimum_value = -1;
 
     int** matrix = load_and_print_jssp_matrix(jss_filename, &num_jobs, &num_machines, &optimum_value);
     if (matrix == NULL) return EXIT_FAILURE;
 
+    // Instances beyond the fixed-size solvers go through the rolling horizon
+    if (horizon.window_jobs > 0 || num_jobs > MAX_JOBS || num_machines > MAX_MACHINES) {
+        if (horizon.window_jobs <= 0) horizon.window_jobs = HORIZON_DEFAULT_WINDOW;
+        int status = solve_rolling_horizon(matrix, num_jobs, num_machines, &horizon);
+        free_matrix(matrix, num_jobs);
+        return status;
+    }
+
     JSSPData data;
 
     initialize_schedule_data(matrix, num_jobs, num_machines, &data);
@@ -392,9 +640,138 @@ int main() {
 
     compute_shifting_bottleneck(&data, &sched);
 
-    //validate_schedule(&sched, &data);
+    // Head to head: the memetic algorithm starts from random chromosomes, not from the SBP
+    if (memetic_seconds > 0.0) {
+        static Schedule evolved;
+        MemeticParams params;
+        default_memetic_params(&params);
+        params.seconds = memetic_seconds;
+        params.num_threads = num_threads;
+
+        MemeticStats stats;
+        int evolved_makespan = memetic_search(&data, NULL, &params, &evolved, &stats);
+        int sbp_makespan = schedule_makespan(&sched, &data);
+        print_memetic_stats(&stats);
+        printf("Memetic vs SBP: %d vs %d\n", evolved_makespan, sbp_makespan);
+        if (evolved_makespan >= 0 && evolved_makespan < sbp_makespan) sched = evolved;
+    }
+
+    // Best-known solution from earlier runs seeds the incumbent
+    static SolutionStore store;
+    bool use_store = store_dir != NULL && open_solution_store(store_dir, &store) == 0;
+    StoredBounds stored = { -1, 0, false };
+    int lower_bound = 0;
+    bool proven_optimal = false;
+    if (use_store) {
+        seed_from_store(&store, &data, &sched, &stored);
+        if (stored.proven_optimal && exact_seconds > 0.0) {
+            printf("Store: optimum already proven, skipping the exact search\n");
+            exact_seconds = 0.0;
+        }
+    }
+
+    // The run continues from the phase the checkpoint was taken in, with the budgets given again
+    static Checkpoint resumed;
+    bool resuming = resume_filename != NULL;
+    if (resuming) {
+        if (read_checkpoint(resume_filename, &data, &resumed) != 0) return EXIT_FAILURE;
+        bool anneal_phase = resumed.phase == CHECKPOINT_ANNEAL;
+        if ((anneal_phase && anneal_seconds <= 0.0) || (!anneal_phase && exact_seconds <= 0.0)) {
+            fprintf(stderr, "Checkpoint: %s was taken during %s, pass that budget again\n", resume_filename,
+                anneal_phase ? "--anneal" : "--exact");
+            return EXIT_FAILURE;
+        }
+        printf("Checkpoint: resuming %s from %s, incumbent %d\n", anneal_phase ? "annealing" : "exact search",
+            resume_filename, resumed.best_makespan);
+    }
+
+    if (anneal_seconds > 0.0 || exact_seconds > 0.0) {
+        static MachineSequences current, best;
+        static Schedule candidate;
+        extract_machine_sequences(&sched, &data, &current);
+        int makespan = schedule_from_sequences(&current, &data, &sched);
+
+        if (resuming && resumed.best_makespan >= 0 && resumed.best_makespan < makespan
+            && schedule_from_sequences(&resumed.best, &data, &candidate) == resumed.best_makespan) {
+            current = resumed.best;
+            makespan = resumed.best_makespan;
+            sched = candidate;
+        }
+
+        if (anneal_seconds > 0.0 && !(resuming && resumed.phase == CHECKPOINT_EXACT)) {
+            AnnealParams params;
+            default_anneal_params(&params);
+            params.seconds = anneal_seconds;
+            params.num_threads = num_threads;
+            params.checkpoint_path = checkpoint_filename;
+            params.checkpoint_interval = checkpoint_interval;
+            if (resuming) params.resume = resumed.tempering;
+
+            AnnealStats stats;
+            if (parallel_tempering(&data, &current, &params, &best, &stats) >= 0) {
+                print_anneal_stats(&stats);
+                current = best;
+                makespan = schedule_from_sequences(&current, &data, &sched);
+            }
+        }
+
+        // Exact search seeded with the best schedule so far as its upper bound
+        if (exact_seconds > 0.0) {
+            BranchBoundParams params = {
+                .num_threads = num_threads,
+                .seconds = exact_seconds,
+                .checkpoint_path = checkpoint_filename,
+                .checkpoint_interval = checkpoint_interval,
+                .resume = resuming && resumed.phase == CHECKPOINT_EXACT ? &resumed.frontier : NULL,
+            };
+            BranchBoundStats stats;
+            int exact = branch_and_bound(&data, makespan >= 0 ? &current : NULL, makespan, &params, &best, &stats);
+            if (makespan < 0 || exact < makespan) {
+                schedule_from_sequences(&best, &data, &sched);
+            }
+            print_branch_bound_stats(&stats);
+            lower_bound = stats.proven_optimal ? stats.best_makespan : stats.root_bound;
+            proven_optimal = stats.proven_optimal;
+        }
+    }
+
+    if (resuming) free_checkpoint(&resumed);
+
+    VerificationReport report;
+    int violations = verify_schedule(&sched, &data, -1, &report);
+    print_verification_report(&report);
+
+    if (use_store) {
+        if (violations == 0) {
+            static MachineSequences final;
+            extract_machine_sequences(&sched, &data, &final);
+            if (record_solution(&store, &data, &final, report.makespan, lower_bound, proven_optimal) > 0) {
+                printf("Store: recorded makespan %d in %s\n", report.makespan, store_dir);
+            }
+        }
+        close_solution_store(&store);
+    }
 
     print_compact_schedule(&sched, &data);
 
-    return 0;
+    // Warm start: repair the schedule above for the changed instance instead of solving it again
+    if (delta_filename != NULL) {
+        static InstanceDelta delta;
+        static MachineSequences previous, repaired;
+        static JSSPData new_data;
+        static Schedule new_sched;
+
+        if (load_instance_delta(delta_filename, data.num_machines, &delta) != 0) return EXIT_FAILURE;
+        extract_machine_sequences(&sched, &data, &previous);
+
+        RescheduleStats stats;
+        if (reschedule(&data, &previous, &delta, &new_data, &repaired, &new_sched, &stats) < 0) return EXIT_FAILURE;
+        print_reschedule_stats(&stats);
+
+        violations += verify_schedule(&new_sched, &new_data, -1, &report);
+        print_verification_report(&report);
+        print_compact_schedule(&new_sched, &new_data);
+    }
+
+    return violations == 0 ? 0 : EXIT_FAILURE;
 }
@@ -0,0 +1,519 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "memetic.h"
+
+#define CACHE_LINE 64
+
+typedef struct {
+    int makespan;
+    uint64_t hash;              // Of the genes, which are canonical: one schedule, one chromosome
+    int genes[MAX_OPERATIONS];
+} Individual;
+
+// Everything a worker touches while breeding. Allocated per thread and cache-line
+// aligned before the first generation, so the hot loop never allocates.
+typedef struct {
+    SequenceGraph graph;
+    MachineSequences seq;
+    int genes[MAX_OPERATIONS];          // Child before decoding
+    int arcs[MAX_OPERATIONS];
+    int next_op[MAX_JOBS];
+    bool keep[MAX_JOBS];
+    long long children;
+    long long improving_moves;
+} Workspace;
+
+typedef struct {
+    const JSSPData* data;
+    const MemeticParams* params;
+    const MachineSequences* seed;
+    int population;
+    int num_threads;
+    int num_genes;
+    Workspace* workspaces[MAX_MEMETIC_THREADS];
+
+    // Written by the serial thread between the two barriers, read-only while breeding
+    Individual* pool;                   // 2 * population slots
+    Individual* parents[MAX_POPULATION];
+    int num_parents;                    // 0 while the first population is being built
+    Individual* children[MAX_POPULATION];
+    int generation;
+    bool stop;
+
+    _Atomic int next_child;
+    pthread_barrier_t barrier;
+    struct timespec start;
+
+    // Best orientation seen, ties broken by (generation, child) so it does not depend on timing
+    pthread_mutex_t best_lock;
+    _Atomic int best_makespan;
+    long long best_key;
+    MachineSequences best;
+} Memetic;
+
+typedef struct {
+    Memetic* ga;
+    int thread;
+} WorkerArgs;
+
+void default_memetic_params(MemeticParams* params) {
+    params->num_threads = 0;
+    params->seconds = 5.0;
+    params->max_generations = 0;
+    params->population = 50;
+    params->descent_moves = 100;
+    params->mutation_rate = 0.1;
+    params->seed = 12345;
+}
+
+// xorshift64*
+static inline uint64_t next_random(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static inline double next_uniform(uint64_t* state) {
+    return (next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// splitmix64 finalizer: spreads (seed, generation, child) over the whole state
+static uint64_t child_seed(uint64_t seed, int generation, int child) {
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL * ((uint64_t)generation * MAX_POPULATION + child + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return z != 0 ? z : 1;
+}
+
+static double seconds_since(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+static uint64_t fnv1a(const int* values, int count) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const unsigned char* bytes = (const unsigned char*)values;
+    for (size_t i = 0; i < count * sizeof(int); i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/**
+ * Decodes a job-repetition chromosome into an active schedule (Giffler-Thompson).
+ * @param data JSSP instance
+ * @param chromosome num_jobs * num_machines genes, each job num_machines times
+ * @param seq Output: machine sequences of the schedule
+ * @return makespan
+ */
+int decode_active_schedule(const JSSPData* data, const int* chromosome, MachineSequences* seq) {
+    int num_jobs = data->num_jobs;
+    int num_machines = data->num_machines;
+    int num_genes = num_jobs * num_machines;
+    int priority[MAX_OPERATIONS];       // Gene position of each operation
+    int next_op[MAX_JOBS];
+    int job_ready[MAX_JOBS];
+    int machine_ready[MAX_MACHINES];
+
+    for (int j = 0; j < num_jobs; j++) {
+        next_op[j] = 0;
+        job_ready[j] = 0;
+    }
+    for (int p = 0; p < num_genes; p++) {
+        int j = chromosome[p];
+        priority[op_node_index(j, num_machines, next_op[j]++)] = p;
+    }
+    for (int j = 0; j < num_jobs; j++) next_op[j] = 0;
+    for (int m = 0; m < num_machines; m++) {
+        machine_ready[m] = 0;
+        seq->length[m] = 0;
+    }
+    seq->num_jobs = num_jobs;
+    seq->num_machines = num_machines;
+
+    int makespan = 0;
+    for (int step = 0; step < num_genes; step++) {
+        // Earliest completion among the schedulable operations fixes the conflict machine
+        int earliest_end = INT_MAX;
+        int earliest_job = -1;
+        int conflict_machine = -1;
+        for (int j = 0; j < num_jobs; j++) {
+            if (next_op[j] == num_machines) continue;
+            const Task* task = &data->operations[j][next_op[j]];
+            int start = job_ready[j] > machine_ready[task->machine] ? job_ready[j] : machine_ready[task->machine];
+            if (start + task->duration < earliest_end) {
+                earliest_end = start + task->duration;
+                earliest_job = j;
+                conflict_machine = task->machine;
+            }
+        }
+
+        // Of the operations that could start before it ends there, the first gene wins
+        // (the earliest one always competes, even with a zero duration)
+        int chosen = -1, chosen_priority = INT_MAX, chosen_start = 0;
+        for (int j = 0; j < num_jobs; j++) {
+            if (next_op[j] == num_machines) continue;
+            const Task* task = &data->operations[j][next_op[j]];
+            if (task->machine != conflict_machine) continue;
+            int start = job_ready[j] > machine_ready[conflict_machine] ? job_ready[j] : machine_ready[conflict_machine];
+            int x = op_node_index(j, num_machines, next_op[j]);
+            if ((start < earliest_end || j == earliest_job) && priority[x] < chosen_priority) {
+                chosen = j;
+                chosen_priority = priority[x];
+                chosen_start = start;
+            }
+        }
+
+        int end = chosen_start + data->operations[chosen][next_op[chosen]].duration;
+        seq->order[conflict_machine][seq->length[conflict_machine]++] = op_node_index(chosen, num_machines, next_op[chosen]);
+        job_ready[chosen] = end;
+        machine_ready[conflict_machine] = end;
+        next_op[chosen]++;
+        if (end > makespan) makespan = end;
+    }
+    return makespan;
+}
+
+/**
+ * Writes the orientation held by g back as a chromosome: operations by start time,
+ * ties by job index, so children inherit the order the descent found.
+ */
+static void genes_from_heads(const SequenceGraph* g, int* next_op, int* genes) {
+    int num_jobs = g->num_jobs;
+    int num_machines = g->num_machines;
+
+    for (int j = 0; j < num_jobs; j++) next_op[j] = 0;
+    for (int p = 0; p < g->num_operations; p++) {
+        int job = -1, earliest = INT_MAX;
+        for (int j = 0; j < num_jobs; j++) {
+            if (next_op[j] == num_machines) continue;
+            int head = g->head[op_node_index(j, num_machines, next_op[j])];
+            if (head < earliest) {
+                earliest = head;
+                job = j;
+            }
+        }
+        genes[p] = job;
+        next_op[job]++;
+    }
+}
+
+static void random_chromosome(int num_jobs, int num_machines, uint64_t* rng, int* genes) {
+    int num_genes = num_jobs * num_machines;
+    for (int p = 0; p < num_genes; p++) genes[p] = p % num_jobs;
+    for (int p = num_genes - 1; p > 0; p--) {
+        int q = (int)(next_random(rng) % (uint64_t)(p + 1));
+        int t = genes[p];
+        genes[p] = genes[q];
+        genes[q] = t;
+    }
+}
+
+// Binary tournament among the parents
+static const Individual* select_parent(const Memetic* ga, uint64_t* rng) {
+    const Individual* a = ga->parents[next_random(rng) % ga->num_parents];
+    const Individual* b = ga->parents[next_random(rng) % ga->num_parents];
+    return b->makespan < a->makespan ? b : a;
+}
+
+/**
+ * Precedence-preserving operation crossover (POX): the genes of a random job subset keep
+ * their positions from the first parent, the free positions take the remaining genes in
+ * the second parent's order. Every job keeps num_machines genes, so the child is feasible.
+ */
+static void pox_crossover(const int* first, const int* second, int num_jobs, int num_genes, uint64_t* rng,
+    bool* keep, int* child) {
+    for (int j = 0; j < num_jobs; j++) keep[j] = next_random(rng) & 1;
+    if (num_jobs > 1) {
+        // A proper, non-empty subset: the child takes something from both parents
+        int in = (int)(next_random(rng) % num_jobs);
+        int out = (in + 1 + (int)(next_random(rng) % (num_jobs - 1))) % num_jobs;
+        keep[in] = true;
+        keep[out] = false;
+    }
+
+    for (int p = 0; p < num_genes; p++) child[p] = keep[first[p]] ? first[p] : -1;
+    int slot = 0;
+    for (int p = 0; p < num_genes; p++) {
+        if (keep[second[p]]) continue;
+        while (child[slot] >= 0) slot++;
+        child[slot++] = second[p];
+    }
+}
+
+/**
+ * First-improvement descent over the critical machine arcs (N1), stopped after
+ * max_moves improving swaps.
+ * @return number of improving swaps
+ */
+static long long short_descent(SequenceGraph* g, int max_moves, int* arcs) {
+    long long accepted = 0;
+
+    while (accepted < max_moves) {
+        bool improved = false;
+        int num_arcs = critical_machine_arcs(g, arcs, MAX_OPERATIONS);
+        for (int i = 0; i < num_arcs && !improved; i++) {
+            int before = g->makespan;
+            int after = swap_adjacent(g, arcs[i]);
+            if (after < 0) continue;
+            if (after < before) {
+                improved = true;
+                accepted++;
+            }
+            else {
+                revert_swap(g);
+            }
+        }
+        if (!improved) break;
+    }
+    return accepted;
+}
+
+static void offer_best(Memetic* ga, Workspace* ws, int makespan, long long key) {
+    if (makespan > atomic_load(&ga->best_makespan)) return;
+
+    pthread_mutex_lock(&ga->best_lock);
+    int best = atomic_load(&ga->best_makespan);
+    if (makespan < best || (makespan == best && key < ga->best_key)) {
+        store_sequence_graph(&ws->graph, &ga->best);
+        ga->best_key = key;
+        atomic_store(&ga->best_makespan, makespan);
+    }
+    pthread_mutex_unlock(&ga->best_lock);
+}
+
+/**
+ * Breeds child slot i of the current generation: crossover and mutation (or a random or
+ * seeded chromosome for the first population), decoding, descent, write-back.
+ */
+static void breed_child(Memetic* ga, Workspace* ws, int i) {
+    const JSSPData* data = ga->data;
+    const MemeticParams* params = ga->params;
+    int num_jobs = data->num_jobs;
+    int num_machines = data->num_machines;
+    Individual* child = ga->children[i];
+    SequenceGraph* g = &ws->graph;
+    uint64_t rng = child_seed(params->seed, ga->generation, i);
+
+    if (ga->num_parents == 0 && i == 0 && ga->seed != NULL) {
+        load_sequence_graph(g, data, ga->seed);
+    }
+    else {
+        if (ga->num_parents == 0) {
+            random_chromosome(num_jobs, num_machines, &rng, ws->genes);
+        }
+        else {
+            const Individual* first = select_parent(ga, &rng);
+            const Individual* second = select_parent(ga, &rng);
+            pox_crossover(first->genes, second->genes, num_jobs, ga->num_genes, &rng, ws->keep, ws->genes);
+            if (next_uniform(&rng) < params->mutation_rate) {
+                int p = (int)(next_random(&rng) % ga->num_genes);
+                int q = (int)(next_random(&rng) % ga->num_genes);
+                int t = ws->genes[p];
+                ws->genes[p] = ws->genes[q];
+                ws->genes[q] = t;
+            }
+        }
+        decode_active_schedule(data, ws->genes, &ws->seq);
+        load_sequence_graph(g, data, &ws->seq);
+    }
+
+    ws->improving_moves += short_descent(g, params->descent_moves, ws->arcs);
+    ws->children++;
+
+    // Lamarckian: the improved schedule replaces the chromosome it came from
+    genes_from_heads(g, ws->next_op, child->genes);
+    child->makespan = g->makespan;
+    child->hash = fnv1a(child->genes, ga->num_genes);
+    offer_best(ga, ws, g->makespan, (long long)ga->generation * MAX_POPULATION + i);
+}
+
+/**
+ * (mu + lambda) truncation: the best population individuals of parents and children,
+ * one per distinct chromosome as long as there are enough. Ties keep the older individual.
+ */
+static void select_survivors(Memetic* ga) {
+    Individual* candidates[2 * MAX_POPULATION];
+    bool chosen[2 * MAX_POPULATION];
+    int n = 0;
+
+    for (int k = 0; k < ga->num_parents; k++) candidates[n++] = ga->parents[k];
+    for (int k = 0; k < ga->population; k++) candidates[n++] = ga->children[k];
+    for (int k = 1; k < n; k++) {
+        Individual* x = candidates[k];
+        int l = k;
+        while (l > 0 && candidates[l - 1]->makespan > x->makespan) {
+            candidates[l] = candidates[l - 1];
+            l--;
+        }
+        candidates[l] = x;
+    }
+
+    int num_parents = 0;
+    for (int k = 0; k < n; k++) {
+        chosen[k] = false;
+        if (num_parents == ga->population) continue;
+        bool duplicate = false;
+        for (int l = 0; l < num_parents && !duplicate; l++) {
+            duplicate = ga->parents[l]->hash == candidates[k]->hash;
+        }
+        if (!duplicate) {
+            ga->parents[num_parents++] = candidates[k];
+            chosen[k] = true;
+        }
+    }
+    for (int k = 0; k < n && num_parents < ga->population; k++) {
+        if (!chosen[k]) {
+            ga->parents[num_parents++] = candidates[k];
+            chosen[k] = true;
+        }
+    }
+    ga->num_parents = num_parents;
+
+    // Every pool slot that is not a parent is free for the next children
+    bool taken[2 * MAX_POPULATION] = { false };
+    for (int k = 0; k < num_parents; k++) taken[ga->parents[k] - ga->pool] = true;
+    int num_children = 0;
+    for (int s = 0; s < 2 * ga->population; s++) {
+        if (!taken[s]) ga->children[num_children++] = &ga->pool[s];
+    }
+}
+
+static void* memetic_worker(void* arg) {
+    WorkerArgs* args = arg;
+    Memetic* ga = args->ga;
+    Workspace* ws = ga->workspaces[args->thread];
+    const MemeticParams* params = ga->params;
+
+    for (;;) {
+        int i;
+        while ((i = atomic_fetch_add(&ga->next_child, 1)) < ga->population) {
+            breed_child(ga, ws, i);
+        }
+
+        // Replacement is the only serial step of a generation
+        if (pthread_barrier_wait(&ga->barrier) == PTHREAD_BARRIER_SERIAL_THREAD) {
+            select_survivors(ga);
+            ga->generation++;
+            ga->stop = seconds_since(&ga->start) >= params->seconds
+                || (params->max_generations > 0 && ga->generation > params->max_generations);
+            atomic_store(&ga->next_child, 0);
+        }
+        pthread_barrier_wait(&ga->barrier);
+
+        if (ga->stop) break;
+    }
+    return NULL;
+}
+
+/**
+ * Runs the memetic algorithm.
+ * @param data JSSP instance
+ * @param seed Acyclic orientation for the first population (may be NULL)
+ * @param params Thread count, time budget, population, descent length, mutation rate
+ * @param sched Output: semi-active schedule of the best orientation
+ * @param stats Output: generation and move counters (may be NULL)
+ * @return best makespan, or -1 if seed is not acyclic
+ */
+int memetic_search(const JSSPData* data, const MachineSequences* seed, const MemeticParams* params,
+    Schedule* sched, MemeticStats* stats) {
+    Memetic* ga = calloc(1, sizeof(Memetic));
+    ga->data = data;
+    ga->params = params;
+    ga->seed = seed;
+    ga->num_genes = data->num_jobs * data->num_machines;
+    ga->population = params->population;
+    if (ga->population < 2) ga->population = 2;
+    if (ga->population > MAX_POPULATION) ga->population = MAX_POPULATION;
+    ga->num_threads = params->num_threads > 0 ? params->num_threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (ga->num_threads < 1) ga->num_threads = 1;
+    if (ga->num_threads > MAX_MEMETIC_THREADS) ga->num_threads = MAX_MEMETIC_THREADS;
+    if (ga->num_threads > ga->population) ga->num_threads = ga->population;
+
+    int result = -1;
+    if (seed != NULL) {
+        SequenceGraph* g = malloc(sizeof(SequenceGraph));
+        bool acyclic = load_sequence_graph(g, data, seed) >= 0;
+        free(g);
+        if (!acyclic) {
+            fprintf(stderr, "Memetic: the seed orientation has a cycle\n");
+            free(ga);
+            return -1;
+        }
+    }
+
+    ga->pool = malloc(2 * ga->population * sizeof(Individual));
+    for (int k = 0; k < ga->population; k++) ga->children[k] = &ga->pool[k];
+    for (int t = 0; t < ga->num_threads; t++) {
+        size_t size = (sizeof(Workspace) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+        ga->workspaces[t] = aligned_alloc(CACHE_LINE, size);
+        ga->workspaces[t]->children = 0;
+        ga->workspaces[t]->improving_moves = 0;
+    }
+    pthread_mutex_init(&ga->best_lock, NULL);
+    atomic_init(&ga->best_makespan, INT_MAX);
+    atomic_init(&ga->next_child, 0);
+    ga->best_key = LLONG_MAX;
+
+    pthread_t threads[MAX_MEMETIC_THREADS];
+    WorkerArgs args[MAX_MEMETIC_THREADS];
+    pthread_barrier_init(&ga->barrier, NULL, ga->num_threads);
+    clock_gettime(CLOCK_MONOTONIC, &ga->start);
+    for (int t = 0; t < ga->num_threads; t++) {
+        args[t].ga = ga;
+        args[t].thread = t;
+        pthread_create(&threads[t], NULL, memetic_worker, &args[t]);
+    }
+    for (int t = 0; t < ga->num_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    pthread_barrier_destroy(&ga->barrier);
+
+    result = atomic_load(&ga->best_makespan);
+    schedule_from_sequences(&ga->best, data, sched);
+
+    if (stats != NULL) {
+        stats->num_threads = ga->num_threads;
+        stats->population = ga->population;
+        stats->generations = ga->generation - 1;    // The first round only built the population
+        stats->best_makespan = result;
+        stats->children = 0;
+        stats->improving_moves = 0;
+        for (int t = 0; t < ga->num_threads; t++) {
+            stats->children += ga->workspaces[t]->children;
+            stats->improving_moves += ga->workspaces[t]->improving_moves;
+        }
+        stats->elapsed = seconds_since(&ga->start);
+    }
+
+    for (int t = 0; t < ga->num_threads; t++) {
+        free(ga->workspaces[t]);
+    }
+    pthread_mutex_destroy(&ga->best_lock);
+    free(ga->pool);
+    free(ga);
+    return result;
+}
+
+void print_memetic_stats(const MemeticStats* stats) {
+    printf("Memetic: %d threads, population %d, %d generations, %.2f s, best makespan %d\n",
+        stats->num_threads, stats->population, stats->generations, stats->elapsed, stats->best_makespan);
+    printf("  Children: %lld (%.0f/s), improving swaps %lld (%.1f per child)\n",
+        stats->children, stats->children / stats->elapsed, stats->improving_moves,
+        stats->children > 0 ? (double)stats->improving_moves / stats->children : 0.0);
+}
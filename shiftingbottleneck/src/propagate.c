@@ -0,0 +1,298 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+
+#include "propagate.h"
+
+void init_propagation(PropagationContext* ctx, int num_operations, int num_machines, int upper_bound) {
+    ctx->upper_bound = upper_bound;
+    ctx->num_machines = num_machines;
+    ctx->num_fixed = 0;
+
+    for (int i = 0; i < num_operations; i++) {
+        ctx->release[i] = 0;
+        ctx->deadline[i] = upper_bound;
+        ctx->last_head[i] = -1;
+        ctx->last_deadline[i] = -1;
+    }
+    for (int m = 0; m < MAX_MACHINES; m++) {
+        ctx->machine_dirty[m] = true;
+    }
+}
+
+/**
+ * Computes heads (earliest starts) and latest finish times of every operation
+ * over the current graph, on top of the bounds already learned in ctx.
+ * @return false if the graph contains a cycle.
+ */
+static bool compute_windows(const PropagationContext* ctx, const OperationNode* nodes, int num_operations, int* head, int* latest_finish) {
+    int in_degree[MAX_OPERATIONS];
+    int order[MAX_OPERATIONS];
+    int front = 0, rear = 0;
+
+    for (int i = 0; i < num_operations; i++) {
+        in_degree[i] = nodes[i].num_predecessors;
+        head[i] = ctx->release[i];
+        latest_finish[i] = ctx->deadline[i];
+        if (in_degree[i] == 0) {
+            order[rear++] = i;
+        }
+    }
+
+    // Forward pass in topological order
+    while (front < rear) {
+        int u_idx = order[front++];
+        const OperationNode* u = &nodes[u_idx];
+        for (int s = 0; s < u->num_successors; s++) {
+            int v = u->successors[s];
+            if (head[u_idx] + u->duration > head[v]) {
+                head[v] = head[u_idx] + u->duration;
+            }
+            if (--in_degree[v] == 0) {
+                order[rear++] = v;
+            }
+        }
+    }
+    if (rear < num_operations) return false;
+
+    // Backward pass over the same order
+    for (int k = num_operations - 1; k >= 0; k--) {
+        int v = order[k];
+        for (int s = 0; s < nodes[v].num_successors; s++) {
+            int w = nodes[v].successors[s];
+            int bound = latest_finish[w] - nodes[w].duration;
+            if (bound < latest_finish[v]) {
+                latest_finish[v] = bound;
+            }
+        }
+    }
+    return true;
+}
+
+// Adds from -> to unless it is already there. Returns 1 if a new arc was fixed,
+// 0 if nothing changed and -1 if the opposite orientation is already fixed.
+static int fix_arc(OperationNode* nodes, int from, int to) {
+    if (has_successor(&nodes[from], to)) return 0;
+    if (has_successor(&nodes[to], from)) return -1;
+    if (nodes[from].num_successors >= MAX_EDGES_PER_NODE || nodes[to].num_predecessors >= MAX_EDGES_PER_NODE) {
+        return 0;  // Leaving a disjunction open is always safe
+    }
+    nodes[from].successors[nodes[from].num_successors++] = to;
+    nodes[to].predecessors[nodes[to].num_predecessors++] = from;
+    touch_node(&nodes[from]);
+    touch_node(&nodes[to]);
+    return 1;
+}
+
+/**
+ * Runs the pair rule, edge-finding and not-first/not-last on the operations of one machine.
+ * Edge-finding is done over task intervals: for every release r_a and deadline d_k the set
+ * Omega = { j : head_j >= r_a, lf_j <= d_k } is tested against every operation outside it.
+ * @return number of new arcs, or PROPAGATION_INFEASIBLE.
+ */
+static int filter_machine(PropagationContext* ctx, OperationNode* nodes, const int* ops, int n, const int* head, const int* lf) {
+    int fixed = 0;
+
+    // Pair rule: if j cannot complete before i must start, i goes first.
+    for (int a = 0; a < n - 1; a++) {
+        for (int b = a + 1; b < n; b++) {
+            int i = ops[a], j = ops[b];
+            int pi = nodes[i].duration, pj = nodes[j].duration;
+            bool j_first_fails = head[j] + pj + pi > lf[i];
+            bool i_first_fails = head[i] + pi + pj > lf[j];
+
+            if (j_first_fails && i_first_fails) return PROPAGATION_INFEASIBLE;
+
+            int r = 0;
+            if (j_first_fails) r = fix_arc(nodes, i, j);
+            else if (i_first_fails) r = fix_arc(nodes, j, i);
+            if (r < 0) return PROPAGATION_INFEASIBLE;
+            fixed += r;
+        }
+    }
+
+    bool in_omega[MAX_OPS_PER_MACHINE];
+    for (int k = 0; k < n; k++) {
+        int d_k = lf[ops[k]];
+        for (int a = 0; a < n; a++) {
+            int r_a = head[ops[a]];
+            int total = 0, count = 0;
+            int min_ect = INT_MAX, max_lst = INT_MIN;
+
+            for (int j = 0; j < n; j++) {
+                int op = ops[j];
+                in_omega[j] = head[op] >= r_a && lf[op] <= d_k;
+                if (in_omega[j]) {
+                    total += nodes[op].duration;
+                    count++;
+                    if (head[op] + nodes[op].duration < min_ect) min_ect = head[op] + nodes[op].duration;
+                    if (lf[op] - nodes[op].duration > max_lst) max_lst = lf[op] - nodes[op].duration;
+                }
+            }
+            if (count == 0) continue;
+            if (r_a + total > d_k) return PROPAGATION_INFEASIBLE;
+
+            for (int x = 0; x < n; x++) {
+                if (in_omega[x]) continue;
+                int i = ops[x];
+                int pi = nodes[i].duration;
+                int r_i = head[i] < r_a ? head[i] : r_a;
+                int d_i = lf[i] > d_k ? lf[i] : d_k;
+                bool last = r_i + total + pi > d_k;     // Omega << i
+                bool first = r_a + total + pi > d_i;    // i << Omega
+
+                if (last && first) return PROPAGATION_INFEASIBLE;
+
+                if (last || first) {
+                    for (int j = 0; j < n; j++) {
+                        if (!in_omega[j]) continue;
+                        int r = last ? fix_arc(nodes, ops[j], i) : fix_arc(nodes, i, ops[j]);
+                        if (r < 0) return PROPAGATION_INFEASIBLE;
+                        fixed += r;
+                    }
+                    if (last && r_a + total > ctx->release[i]) ctx->release[i] = r_a + total;
+                    if (first && d_k - total < ctx->deadline[i]) ctx->deadline[i] = d_k - total;
+                    continue;
+                }
+
+                // Not-first: i cannot precede all of Omega, so something in Omega ends before i starts.
+                if (head[i] + pi + total > d_k && min_ect > ctx->release[i]) {
+                    ctx->release[i] = min_ect;
+                }
+                // Not-last: i cannot follow all of Omega, so something in Omega starts after i ends.
+                if (r_a + total + pi > lf[i] && max_lst < ctx->deadline[i]) {
+                    ctx->deadline[i] = max_lst;
+                }
+            }
+        }
+    }
+
+    return fixed;
+}
+
+/**
+ * Propagates the makespan bound held in ctx over the operation graph.
+ * Only machines whose operation windows moved since the previous call are filtered,
+ * so calling this after every orientation only pays for the affected machines.
+ * @param ctx Propagation state created by init_propagation
+ * @param nodes Global array of OperationNode, receives the fixed arcs
+ * @param num_operations Number of nodes
+ * @return number of disjunctions settled by this call, or PROPAGATION_INFEASIBLE
+ */
+int propagate_disjunctions(PropagationContext* ctx, OperationNode* nodes, int num_operations) {
+    int* saved_succ = ctx->saved_succ;
+    int* saved_pred = ctx->saved_pred;
+    int* saved_release = ctx->saved_release;
+    int* saved_deadline = ctx->saved_deadline;
+    int* head = ctx->head;
+    int* lf = ctx->lf;
+    DisjunctiveSets* sets = &ctx->sets;
+
+    // Arcs are only ever appended, so restoring the counts undoes this call.
+    for (int i = 0; i < num_operations; i++) {
+        saved_succ[i] = nodes[i].num_successors;
+        saved_pred[i] = nodes[i].num_predecessors;
+        saved_release[i] = ctx->release[i];
+        saved_deadline[i] = ctx->deadline[i];
+    }
+    build_machine_ops(nodes, num_operations, ctx->num_machines, sets);
+
+    int fixed = 0;
+    bool infeasible = false;
+
+    while (!infeasible) {
+        if (!compute_windows(ctx, nodes, num_operations, head, lf)) {
+            infeasible = true;
+            break;
+        }
+
+        for (int i = 0; i < num_operations; i++) {
+            if (head[i] + nodes[i].duration > lf[i]) {
+                infeasible = true;
+                break;
+            }
+            if (head[i] != ctx->last_head[i] || lf[i] != ctx->last_deadline[i]) {
+                ctx->machine_dirty[nodes[i].machine] = true;
+                ctx->last_head[i] = head[i];
+                ctx->last_deadline[i] = lf[i];
+            }
+        }
+        if (infeasible) break;
+
+        bool any_dirty = false;
+        for (int m = 0; m < ctx->num_machines; m++) {
+            if (!ctx->machine_dirty[m]) continue;
+            ctx->machine_dirty[m] = false;
+            any_dirty = true;
+
+            int r = filter_machine(ctx, nodes, sets->machines[m].op_indices, sets->machines[m].num_ops, head, lf);
+            if (r < 0) {
+                infeasible = true;
+                break;
+            }
+            fixed += r;
+        }
+
+        // Nothing was rescanned: windows are stable and no new arc can be derived
+        if (!any_dirty) break;
+    }
+
+    if (infeasible) {
+        for (int i = 0; i < num_operations; i++) {
+            if (nodes[i].num_successors != saved_succ[i] || nodes[i].num_predecessors != saved_pred[i]) {
+                nodes[i].num_successors = saved_succ[i];
+                nodes[i].num_predecessors = saved_pred[i];
+                touch_node(&nodes[i]);
+            }
+            ctx->release[i] = saved_release[i];
+            ctx->deadline[i] = saved_deadline[i];
+            ctx->last_head[i] = -1;
+            ctx->last_deadline[i] = -1;
+        }
+        return PROPAGATION_INFEASIBLE;
+    }
+
+    for (int i = 0; i < num_operations; i++) {
+        nodes[i].latest_finish = lf[i];
+    }
+
+    ctx->num_fixed += fixed;
+    return fixed;
+}
+
+/**
+ * Builds a non-delay schedule by always starting the job operation that can start first
+ * (shortest duration breaks ties) and returns its makespan.
+ * @param data JSSP instance
+ * @return makespan of the dispatched schedule, a valid upper bound
+ */
+int greedy_upper_bound(const JSSPData* data) {
+    int next_op[MAX_JOBS] = { 0 };
+    int job_ready[MAX_JOBS] = { 0 };
+    int machine_ready[MAX_MACHINES] = { 0 };
+    int makespan = 0;
+
+    for (int step = 0; step < data->num_jobs * data->num_machines; step++) {
+        int best_job = -1, best_start = INT_MAX, best_duration = INT_MAX;
+
+        for (int j = 0; j < data->num_jobs; j++) {
+            if (next_op[j] >= data->num_machines) continue;
+            Task t = data->operations[j][next_op[j]];
+            int start = job_ready[j] > machine_ready[t.machine] ? job_ready[j] : machine_ready[t.machine];
+            if (start < best_start || (start == best_start && t.duration < best_duration)) {
+                best_job = j;
+                best_start = start;
+                best_duration = t.duration;
+            }
+        }
+
+        Task t = data->operations[best_job][next_op[best_job]++];
+        int end = best_start + t.duration;
+        job_ready[best_job] = end;
+        machine_ready[t.machine] = end;
+        if (end > makespan) makespan = end;
+    }
+
+    return makespan;
+}
@@ -0,0 +1,355 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "reschedule.h"
+
+#define MAX_DESCENT_ROUNDS 10000
+
+static double seconds_since(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+/**
+ * Builds the changed instance and the map from previous to new job indices.
+ * @return 0, or -1 if the delta refers to jobs/operations/machines that do not exist,
+ *         adds a job that does not visit every machine exactly once, or sets a negative duration
+ */
+static int apply_delta(const JSSPData* data, const InstanceDelta* delta, JSSPData* new_data, int* job_map) {
+    int num_machines = data->num_machines;
+
+    for (int j = 0; j < data->num_jobs; j++) job_map[j] = 0;
+    for (int r = 0; r < delta->num_removed; r++) {
+        int j = delta->removed_jobs[r];
+        if (j < 0 || j >= data->num_jobs) {
+            fprintf(stderr, "Delta removes unknown job %d\n", j);
+            return -1;
+        }
+        job_map[j] = -1;
+    }
+
+    int num_jobs = 0;
+    for (int j = 0; j < data->num_jobs; j++) {
+        if (job_map[j] < 0) continue;
+        job_map[j] = num_jobs;
+        memcpy(new_data->operations[num_jobs], data->operations[j], num_machines * sizeof(Task));
+        num_jobs++;
+    }
+
+    if (num_jobs + delta->num_added > MAX_JOBS) {
+        fprintf(stderr, "Delta grows the instance past MAX_JOBS (%d)\n", MAX_JOBS);
+        return -1;
+    }
+    for (int a = 0; a < delta->num_added; a++) {
+        // Every machine holds at most one operation per job
+        bool visited[MAX_MACHINES] = { false };
+        for (int o = 0; o < num_machines; o++) {
+            int m = delta->added_jobs[a][o].machine;
+            if (m < 0 || m >= num_machines) {
+                fprintf(stderr, "Added job %d uses unknown machine %d\n", a, m);
+                return -1;
+            }
+            if (visited[m]) {
+                fprintf(stderr, "Added job %d visits machine %d more than once\n", a, m);
+                return -1;
+            }
+            visited[m] = true;
+            if (delta->added_jobs[a][o].duration < 0) {
+                fprintf(stderr, "Added job %d has negative duration %d on op %d\n", a, delta->added_jobs[a][o].duration, o);
+                return -1;
+            }
+        }
+        memcpy(new_data->operations[num_jobs + a], delta->added_jobs[a], num_machines * sizeof(Task));
+    }
+    new_data->num_jobs = num_jobs + delta->num_added;
+    new_data->num_machines = num_machines;
+
+    for (int c = 0; c < delta->num_changes; c++) {
+        const DurationChange* change = &delta->changes[c];
+        if (change->job < 0 || change->job >= data->num_jobs || change->op < 0 || change->op >= num_machines) {
+            fprintf(stderr, "Delta changes unknown operation (%d, %d)\n", change->job, change->op);
+            return -1;
+        }
+        if (change->duration < 0) {
+            fprintf(stderr, "Delta sets negative duration %d on operation (%d, %d)\n", change->duration, change->job, change->op);
+            return -1;
+        }
+        if (job_map[change->job] < 0) continue;  // Removed anyway
+        new_data->operations[job_map[change->job]][change->op].duration = change->duration;
+    }
+
+    for (int d = 0; d < delta->num_downtimes; d++) {
+        if (delta->downtimes[d].machine < 0 || delta->downtimes[d].machine >= num_machines) {
+            fprintf(stderr, "Delta takes down unknown machine %d\n", delta->downtimes[d].machine);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Moves the detached operation x to the position on its machine with the lowest makespan,
+// walking it from the end of the list towards the front one adjacent swap at a time.
+static void insert_operation(SequenceGraph* g, int x, RescheduleStats* stats) {
+    int best_makespan = append_operation(g, x);
+    int steps = 0, best_steps = 0;
+
+    while (g->machine_prev[x] >= 0) {
+        int makespan = swap_adjacent(g, g->machine_prev[x]);
+        stats->swaps_tried++;
+        if (makespan < 0) break;  // Any earlier position would close a cycle
+        steps++;
+        if (makespan <= best_makespan) {
+            best_makespan = makespan;
+            best_steps = steps;
+        }
+    }
+    for (; steps > best_steps; steps--) {
+        swap_adjacent(g, x);
+    }
+}
+
+static bool overlaps_downtime(const SequenceGraph* g, int x, const MachineDowntime* down) {
+    return g->head[x] < down->to && g->head[x] + g->duration[x] > down->from;
+}
+
+// Right-shifts every operation that overlaps a downtime of its machine.
+static void repair_downtimes(SequenceGraph* g, const InstanceDelta* delta, RescheduleStats* stats) {
+    bool pushed = true;
+    while (pushed) {
+        pushed = false;
+        for (int d = 0; d < delta->num_downtimes; d++) {
+            const MachineDowntime* down = &delta->downtimes[d];
+            for (int x = g->machine_first[down->machine]; x >= 0; x = g->machine_next[x]) {
+                if (overlaps_downtime(g, x, down)) {
+                    set_release(g, x, down->to);
+                    stats->pushed_ops++;
+                    pushed = true;
+                }
+            }
+        }
+    }
+}
+
+static bool violates_downtimes(const SequenceGraph* g, const InstanceDelta* delta) {
+    for (int d = 0; d < delta->num_downtimes; d++) {
+        const MachineDowntime* down = &delta->downtimes[d];
+        for (int x = g->machine_first[down->machine]; x >= 0; x = g->machine_next[x]) {
+            if (overlaps_downtime(g, x, down)) return true;
+        }
+    }
+    return false;
+}
+
+// First-improvement descent over critical arcs, restricted to the impacted machines.
+static void reoptimize_machines(SequenceGraph* g, const bool* impacted, const InstanceDelta* delta, RescheduleStats* stats) {
+    int arcs[MAX_OPERATIONS];
+
+    for (int round = 0; round < MAX_DESCENT_ROUNDS; round++) {
+        bool improved = false;
+        int num_arcs = critical_machine_arcs(g, arcs, MAX_OPERATIONS);
+
+        for (int i = 0; i < num_arcs && !improved; i++) {
+            int u = arcs[i];
+            if (!impacted[g->machine_of[u]]) continue;
+
+            int before = g->makespan;
+            int after = swap_adjacent(g, u);
+            stats->swaps_tried++;
+            if (after < 0) continue;
+
+            if (after < before && !violates_downtimes(g, delta)) {
+                stats->swaps_accepted++;
+                improved = true;
+            }
+            else {
+                revert_swap(g);
+            }
+        }
+        if (!improved) break;
+    }
+}
+
+/**
+ * Repairs the previous orientation for the changed instance.
+ * @param data Previous instance
+ * @param previous Its orientation (e.g. extracted from the last schedule)
+ * @param delta Removed/added jobs, duration changes and machine downtimes
+ * @param new_data Output: changed instance
+ * @param sequences Output: repaired orientation of new_data
+ * @param sched Output: its schedule, downtimes included
+ * @param stats Output: repair counters (may be NULL)
+ * @return new makespan, or -1 on an invalid delta or a cyclic previous orientation
+ */
+int reschedule(const JSSPData* data, const MachineSequences* previous, const InstanceDelta* delta,
+    JSSPData* new_data, MachineSequences* sequences, Schedule* sched, RescheduleStats* stats) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    RescheduleStats local;
+    if (stats == NULL) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+
+    int job_map[MAX_JOBS];
+    if (apply_delta(data, delta, new_data, job_map) != 0) return -1;
+
+    int num_machines = data->num_machines;
+    int num_kept = new_data->num_jobs - delta->num_added;
+
+    // Previous machine orders with the removed jobs dropped and the rest renumbered
+    sequences->num_jobs = new_data->num_jobs;
+    sequences->num_machines = num_machines;
+    for (int m = 0; m < num_machines; m++) {
+        sequences->length[m] = 0;
+        for (int i = 0; i < previous->length[m]; i++) {
+            int x = previous->order[m][i];
+            int job = job_map[x / num_machines];
+            if (job < 0) {
+                stats->removed_ops++;
+                continue;
+            }
+            sequences->order[m][sequences->length[m]++] = op_node_index(job, num_machines, x % num_machines);
+        }
+    }
+
+    // Previous start times, to tell which machines the delta actually disturbed
+    SequenceGraph* g = malloc(sizeof(SequenceGraph));
+    int previous_start[MAX_OPERATIONS];
+    if (load_sequence_graph(g, data, previous) < 0) {
+        fprintf(stderr, "Previous orientation contains a cycle, cannot reschedule\n");
+        free(g);
+        return -1;
+    }
+    for (int x = 0; x < data->num_jobs * num_machines; x++) {
+        int job = job_map[x / num_machines];
+        if (job >= 0) previous_start[op_node_index(job, num_machines, x % num_machines)] = g->head[x];
+    }
+
+    // One full evaluation of the surviving orientation; the added jobs start detached
+    int makespan = load_sequence_graph(g, new_data, sequences);
+    if (makespan < 0) {
+        free(g);
+        return -1;
+    }
+
+    for (int j = num_kept; j < new_data->num_jobs; j++) {
+        for (int o = 0; o < num_machines; o++) {
+            insert_operation(g, op_node_index(j, num_machines, o), stats);
+            stats->inserted_ops++;
+        }
+    }
+
+    repair_downtimes(g, delta, stats);
+
+    // Impacted: the machine of an inserted or re-timed operation, or of one that moved
+    bool impacted[MAX_MACHINES] = { false };
+    for (int x = 0; x < g->num_operations; x++) {
+        if (x / num_machines >= num_kept || g->head[x] != previous_start[x]) impacted[g->machine_of[x]] = true;
+    }
+    for (int c = 0; c < delta->num_changes; c++) {
+        int job = job_map[delta->changes[c].job];
+        if (job >= 0) impacted[g->machine_of[op_node_index(job, num_machines, delta->changes[c].op)]] = true;
+    }
+    for (int m = 0; m < num_machines; m++) stats->impacted_machines += impacted[m];
+
+    reoptimize_machines(g, impacted, delta, stats);
+
+    store_sequence_graph(g, sequences);
+    memset(sched->job_ready, 0, sizeof(sched->job_ready));
+    memset(sched->machine_ready, 0, sizeof(sched->machine_ready));
+    for (int j = 0; j < new_data->num_jobs; j++) {
+        for (int o = 0; o < num_machines; o++) {
+            int x = op_node_index(j, num_machines, o);
+            int end = g->head[x] + g->duration[x];
+            sched->start_time[j][o] = g->head[x];
+            sched->end_time[j][o] = end;
+            if (end > sched->job_ready[j]) sched->job_ready[j] = end;
+            if (end > sched->machine_ready[g->machine_of[x]]) sched->machine_ready[g->machine_of[x]] = end;
+        }
+    }
+
+    makespan = g->makespan;
+    free(g);
+
+    stats->makespan = makespan;
+    stats->elapsed = seconds_since(&start);
+    return makespan;
+}
+
+/**
+ * Parses a delta file (format in reschedule.h).
+ * @param path File path, used as given
+ * @param num_machines Machines of the instance, i.e. operations per added job
+ * @param delta Output
+ * @return 0 on success, -1 on a missing file or a malformed line
+ */
+int load_instance_delta(const char* path, int num_machines, InstanceDelta* delta) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "Could not open delta file %s\n", path);
+        return -1;
+    }
+
+    memset(delta, 0, sizeof(*delta));
+    char line[1024];
+    int line_number = 0;
+    int status = 0;
+
+    while (status == 0 && fgets(line, sizeof(line), file)) {
+        line_number++;
+        char keyword[16];
+        int consumed = 0;
+        if (sscanf(line, "%15s%n", keyword, &consumed) != 1 || keyword[0] == '#') continue;
+        const char* rest = line + consumed;
+
+        if (strcmp(keyword, "remove") == 0 && delta->num_removed < MAX_JOBS) {
+            if (sscanf(rest, "%d", &delta->removed_jobs[delta->num_removed]) == 1) {
+                delta->num_removed++;
+                continue;
+            }
+        }
+        else if (strcmp(keyword, "add") == 0 && delta->num_added < MAX_JOBS) {
+            Task* job = delta->added_jobs[delta->num_added];
+            int o = 0;
+            while (o < num_machines && sscanf(rest, "%d %d%n", &job[o].machine, &job[o].duration, &consumed) == 2) {
+                rest += consumed;
+                o++;
+            }
+            if (o == num_machines) {
+                delta->num_added++;
+                continue;
+            }
+        }
+        else if (strcmp(keyword, "duration") == 0 && delta->num_changes < MAX_OPERATIONS) {
+            DurationChange* change = &delta->changes[delta->num_changes];
+            if (sscanf(rest, "%d %d %d", &change->job, &change->op, &change->duration) == 3) {
+                delta->num_changes++;
+                continue;
+            }
+        }
+        else if (strcmp(keyword, "down") == 0 && delta->num_downtimes < MAX_DOWNTIMES) {
+            MachineDowntime* down = &delta->downtimes[delta->num_downtimes];
+            if (sscanf(rest, "%d %d %d", &down->machine, &down->from, &down->to) == 3) {
+                delta->num_downtimes++;
+                continue;
+            }
+        }
+
+        fprintf(stderr, "%s:%d: cannot parse '%s'\n", path, line_number, keyword);
+        status = -1;
+    }
+
+    fclose(file);
+    return status;
+}
+
+void print_reschedule_stats(const RescheduleStats* stats) {
+    printf("Rescheduled in %.3f ms, makespan %d\n", stats->elapsed * 1e3, stats->makespan);
+    printf("  Operations: %d removed, %d inserted, %d right-shifted past downtimes\n",
+        stats->removed_ops, stats->inserted_ops, stats->pushed_ops);
+    printf("  Re-optimized %d machine(s): %lld swaps tried, %lld accepted\n",
+        stats->impacted_machines, stats->swaps_tried, stats->swaps_accepted);
+}
@@ -0,0 +1,359 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sequence.h"
+
+typedef struct {
+    int start;
+    int node;
+} StartEntry;
+
+static int compare_start_entries(const void* a, const void* b) {
+    const StartEntry* x = a;
+    const StartEntry* y = b;
+    if (x->start != y->start) return x->start < y->start ? -1 : 1;
+    return x->node - y->node;
+}
+
+void extract_machine_sequences(const Schedule* sched, const JSSPData* data, MachineSequences* seq) {
+    StartEntry entries[MAX_MACHINES][MAX_OPS_PER_MACHINE];
+
+    seq->num_jobs = data->num_jobs;
+    seq->num_machines = data->num_machines;
+    for (int m = 0; m < data->num_machines; m++) {
+        seq->length[m] = 0;
+    }
+
+    for (int j = 0; j < data->num_jobs; j++) {
+        for (int o = 0; o < data->num_machines; o++) {
+            int m = data->operations[j][o].machine;
+            StartEntry* e = &entries[m][seq->length[m]++];
+            e->start = sched->start_time[j][o];
+            e->node = op_node_index(j, data->num_machines, o);
+        }
+    }
+
+    for (int m = 0; m < data->num_machines; m++) {
+        qsort(entries[m], seq->length[m], sizeof(StartEntry), compare_start_entries);
+        for (int i = 0; i < seq->length[m]; i++) {
+            seq->order[m][i] = entries[m][i].node;
+        }
+    }
+}
+
+static inline int job_prev(const SequenceGraph* g, int x) {
+    return x % g->num_machines > 0 ? x - 1 : -1;
+}
+
+static inline int job_next(const SequenceGraph* g, int x) {
+    return x % g->num_machines < g->num_machines - 1 ? x + 1 : -1;
+}
+
+static inline int earliest_head(const SequenceGraph* g, int x) {
+    int head = g->release[x];
+    int p = job_prev(g, x);
+    if (p >= 0 && g->head[p] + g->duration[p] > head) head = g->head[p] + g->duration[p];
+    p = g->machine_prev[x];
+    if (p >= 0 && g->head[p] + g->duration[p] > head) head = g->head[p] + g->duration[p];
+    return head;
+}
+
+// The last operation of some job always finishes last.
+static int makespan_from_heads(const SequenceGraph* g) {
+    int makespan = 0;
+    for (int j = 0; j < g->num_jobs; j++) {
+        int last = op_node_index(j, g->num_machines, g->num_machines - 1);
+        if (g->head[last] + g->duration[last] > makespan) {
+            makespan = g->head[last] + g->duration[last];
+        }
+    }
+    return makespan;
+}
+
+int evaluate_sequence_graph(SequenceGraph* g) {
+    int front = 0, rear = 0;
+
+    for (int x = 0; x < g->num_operations; x++) {
+        g->cone_degree[x] = (job_prev(g, x) >= 0) + (g->machine_prev[x] >= 0);
+        if (g->cone_degree[x] == 0) {
+            g->queue[rear++] = x;
+        }
+    }
+
+    while (front < rear) {
+        int x = g->queue[front++];
+        g->head[x] = earliest_head(g, x);
+
+        int succ[2] = { job_next(g, x), g->machine_next[x] };
+        for (int s = 0; s < 2; s++) {
+            if (succ[s] >= 0 && --g->cone_degree[succ[s]] == 0) {
+                g->queue[rear++] = succ[s];
+            }
+        }
+    }
+
+    g->last_swapped = -1;
+    if (rear < g->num_operations) return -1;
+
+    g->makespan = makespan_from_heads(g);
+    return g->makespan;
+}
+
+int load_sequence_graph(SequenceGraph* g, const JSSPData* data, const MachineSequences* seq) {
+    g->num_jobs = data->num_jobs;
+    g->num_machines = data->num_machines;
+    g->num_operations = data->num_jobs * data->num_machines;
+    g->stamp = 0;
+
+    for (int j = 0; j < data->num_jobs; j++) {
+        for (int o = 0; o < data->num_machines; o++) {
+            int x = op_node_index(j, data->num_machines, o);
+            g->duration[x] = data->operations[j][o].duration;
+            g->machine_of[x] = data->operations[j][o].machine;
+            g->release[x] = 0;
+            g->mark[x] = 0;
+        }
+    }
+
+    // Operations missing from seq stay detached: only their job arcs count
+    for (int x = 0; x < g->num_operations; x++) {
+        g->machine_prev[x] = -1;
+        g->machine_next[x] = -1;
+    }
+    for (int m = 0; m < data->num_machines; m++) {
+        g->machine_first[m] = seq->length[m] > 0 ? seq->order[m][0] : -1;
+        for (int i = 0; i < seq->length[m]; i++) {
+            int x = seq->order[m][i];
+            g->machine_prev[x] = i > 0 ? seq->order[m][i - 1] : -1;
+            g->machine_next[x] = i + 1 < seq->length[m] ? seq->order[m][i + 1] : -1;
+        }
+    }
+
+    return evaluate_sequence_graph(g);
+}
+
+void store_sequence_graph(const SequenceGraph* g, MachineSequences* seq) {
+    seq->num_jobs = g->num_jobs;
+    seq->num_machines = g->num_machines;
+    for (int m = 0; m < g->num_machines; m++) {
+        seq->length[m] = 0;
+        for (int x = g->machine_first[m]; x >= 0; x = g->machine_next[x]) {
+            seq->order[m][seq->length[m]++] = x;
+        }
+    }
+}
+
+int schedule_from_sequences(const MachineSequences* seq, const JSSPData* data, Schedule* sched) {
+    SequenceGraph* g = malloc(sizeof(SequenceGraph));
+    int makespan = load_sequence_graph(g, data, seq);
+
+    if (makespan >= 0) {
+        memset(sched->job_ready, 0, sizeof(sched->job_ready));
+        memset(sched->machine_ready, 0, sizeof(sched->machine_ready));
+        for (int j = 0; j < data->num_jobs; j++) {
+            for (int o = 0; o < data->num_machines; o++) {
+                int x = op_node_index(j, data->num_machines, o);
+                int end = g->head[x] + g->duration[x];
+                sched->start_time[j][o] = g->head[x];
+                sched->end_time[j][o] = end;
+                if (end > sched->job_ready[j]) sched->job_ready[j] = end;
+                if (end > sched->machine_ready[g->machine_of[x]]) sched->machine_ready[g->machine_of[x]] = end;
+            }
+        }
+    }
+
+    free(g);
+    return makespan;
+}
+
+// Exchanges u and v = machine_next[u] in the machine list, without evaluating anything.
+static void relink_swap(SequenceGraph* g, int u) {
+    int v = g->machine_next[u];
+    int a = g->machine_prev[u];
+    int b = g->machine_next[v];
+
+    g->machine_prev[v] = a;
+    if (a >= 0) g->machine_next[a] = v;
+    else g->machine_first[g->machine_of[u]] = v;
+
+    g->machine_next[v] = u;
+    g->machine_prev[u] = v;
+    g->machine_next[u] = b;
+    if (b >= 0) g->machine_prev[b] = u;
+}
+
+/**
+ * Re-evaluates the heads of everything reachable from root, in topological order.
+ * Only this cone can change when root's incoming arcs, release or duration change.
+ * @param g Orientation, heads valid outside the cone
+ * @param root First operation whose head may be stale
+ * @return 0, or -1 if the cone contains a cycle (heads restored)
+ */
+static int update_cone(SequenceGraph* g, int root) {
+    if (++g->stamp == 0) {
+        memset(g->mark, 0, sizeof(g->mark));
+        g->stamp = 1;
+    }
+
+    // Collect the cone and save the heads it may overwrite
+    g->cone_size = 0;
+    g->cone[g->cone_size++] = root;
+    g->mark[root] = g->stamp;
+    for (int i = 0; i < g->cone_size; i++) {
+        int x = g->cone[i];
+        g->saved_head[i] = g->head[x];
+        g->cone_degree[x] = 0;
+
+        int succ[2] = { job_next(g, x), g->machine_next[x] };
+        for (int s = 0; s < 2; s++) {
+            if (succ[s] >= 0 && g->mark[succ[s]] != g->stamp) {
+                g->mark[succ[s]] = g->stamp;
+                g->cone[g->cone_size++] = succ[s];
+            }
+        }
+    }
+
+    // In-degrees restricted to the cone
+    for (int i = 0; i < g->cone_size; i++) {
+        int x = g->cone[i];
+        int succ[2] = { job_next(g, x), g->machine_next[x] };
+        for (int s = 0; s < 2; s++) {
+            if (succ[s] >= 0) g->cone_degree[succ[s]]++;
+        }
+    }
+
+    // Kahn over the cone
+    int front = 0, rear = 0;
+    for (int i = 0; i < g->cone_size; i++) {
+        if (g->cone_degree[g->cone[i]] == 0) g->queue[rear++] = g->cone[i];
+    }
+    while (front < rear) {
+        int x = g->queue[front++];
+        g->head[x] = earliest_head(g, x);
+
+        int succ[2] = { job_next(g, x), g->machine_next[x] };
+        for (int s = 0; s < 2; s++) {
+            if (succ[s] >= 0 && --g->cone_degree[succ[s]] == 0) {
+                g->queue[rear++] = succ[s];
+            }
+        }
+    }
+
+    if (rear < g->cone_size) {
+        for (int i = 0; i < g->cone_size; i++) {
+            g->head[g->cone[i]] = g->saved_head[i];
+        }
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Swaps u with its machine successor v and updates heads incrementally.
+ * Only the cone of v (everything reachable from it after the swap) can change.
+ * @param g Orientation
+ * @param u Operation to move one position later on its machine
+ * @return new makespan, or -1 if the swap creates a cycle (g is restored)
+ */
+int swap_adjacent(SequenceGraph* g, int u) {
+    int v = g->machine_next[u];
+    if (v < 0) return -1;
+
+    relink_swap(g, u);
+    if (update_cone(g, v) < 0) {
+        relink_swap(g, v);
+        return -1;
+    }
+
+    g->saved_makespan = g->makespan;
+    g->makespan = makespan_from_heads(g);
+    g->last_swapped = u;
+    return g->makespan;
+}
+
+/**
+ * Links a detached operation after the last operation of its machine.
+ * Cannot close a cycle: nothing on the machine is reachable from a detached operation
+ * whose job successors are still detached.
+ * @param g Orientation
+ * @param x Operation not yet in its machine list
+ * @return new makespan
+ */
+int append_operation(SequenceGraph* g, int x) {
+    int m = g->machine_of[x];
+    int last = g->machine_first[m];
+    while (last >= 0 && g->machine_next[last] >= 0) last = g->machine_next[last];
+
+    g->machine_prev[x] = last;
+    g->machine_next[x] = -1;
+    if (last >= 0) g->machine_next[last] = x;
+    else g->machine_first[m] = x;
+
+    update_cone(g, x);
+    g->makespan = makespan_from_heads(g);
+    g->last_swapped = -1;
+    return g->makespan;
+}
+
+/**
+ * Raises the release of x (e.g. to move it past a machine outage) and updates its cone.
+ * @param g Orientation
+ * @param x Operation
+ * @param release New lower bound on the head of x; lower values are ignored
+ * @return new makespan
+ */
+int set_release(SequenceGraph* g, int x, int release) {
+    if (release > g->release[x]) {
+        g->release[x] = release;
+        update_cone(g, x);
+        g->makespan = makespan_from_heads(g);
+    }
+    g->last_swapped = -1;
+    return g->makespan;
+}
+
+void revert_swap(SequenceGraph* g) {
+    int u = g->last_swapped;
+    if (u < 0) return;
+
+    relink_swap(g, g->machine_prev[u]);
+    for (int i = 0; i < g->cone_size; i++) {
+        g->head[g->cone[i]] = g->saved_head[i];
+    }
+    g->makespan = g->saved_makespan;
+    g->last_swapped = -1;
+}
+
+/**
+ * Walks one critical path back from the last-finishing operation, preferring machine
+ * predecessors on ties, and records its machine arcs.
+ * @param g Evaluated orientation
+ * @param arcs Output: u for every critical arc (u, machine_next[u])
+ * @param max_arcs Capacity of arcs
+ * @return number of critical machine arcs
+ */
+int critical_machine_arcs(const SequenceGraph* g, int* arcs, int max_arcs) {
+    int x = -1;
+    for (int j = 0; j < g->num_jobs && x < 0; j++) {
+        int last = op_node_index(j, g->num_machines, g->num_machines - 1);
+        if (g->head[last] + g->duration[last] == g->makespan) x = last;
+    }
+
+    int count = 0;
+    while (x >= 0 && g->head[x] > g->release[x]) {
+        int mp = g->machine_prev[x];
+        int jp = job_prev(g, x);
+        if (mp >= 0 && g->head[mp] + g->duration[mp] == g->head[x]) {
+            if (count < max_arcs) arcs[count++] = mp;
+            x = mp;
+        }
+        else if (jp >= 0 && g->head[jp] + g->duration[jp] == g->head[x]) {
+            x = jp;
+        }
+        else {
+            break;
+        }
+    }
+    return count;
+}
@@ -2,9 +2,20 @@
 #include <stdlib.h>
 #include <limits.h>
 #include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SSMS_BATCH_X86 1
+#endif
 
 #include "ssms.h"
 
+#if MAX_JOBS > 64
+#error "The specialized kernels track a machine's jobs in a 64-bit mask"
+#endif
+
 int solve_single_machine_subproblem_naive(OperationNode* nodes, int* ops_on_machine, int num_ops, int* best_sequence) {
     // Naive sequence: preserve order of ops_on_machine
     for (int i = 0; i < num_ops; i++) {
@@ -27,8 +38,40 @@ static int* best_perm = NULL;
 static int best_makespan;
 static OperationNode* global_nodes = NULL;  // global access to nodes array
 
-// Helper: evaluate makespan of a permutation
-static int evaluate_permutation(OperationNode* nodes, int* ops_on_machine, const int* perm, int n) {
+// Helper: true if perm puts an operation after one of its fixed successors on the same machine
+// (with delays: after any operation it reaches through the graph)
+static bool violates_fixed_arcs(OperationNode* nodes, int* ops_on_machine, const int* perm, int n, const DelayedPrecedences* delays) {
+    for (int i = 1; i < n; i++) {
+        OperationNode* later = &nodes[ops_on_machine[perm[i]]];
+        for (int j = 0; j < i; j++) {
+            if (delays != NULL ? delays->delay[perm[i]][perm[j]] >= 0 : has_successor(later, ops_on_machine[perm[j]]))
+                return true;
+        }
+    }
+    return false;
+}
+
+// Helper: makespan of a permutation where each operation also waits for the delayed
+// precedences of the operations sequenced before it
+static int evaluate_with_delays(OperationNode* nodes, int* ops_on_machine, const int* perm, int n, const DelayedPrecedences* delays) {
+    int start[MAX_OPS_PER_MACHINE];     // By position in ops_on_machine
+    int machine_ready = 0;
+    for (int i = 0; i < n; i++) {
+        int x = perm[i];
+        OperationNode* op = &nodes[ops_on_machine[x]];
+        int est = machine_ready > op->earliest_start ? machine_ready : op->earliest_start;
+        for (int j = 0; j < i; j++) {
+            int delay = delays->delay[perm[j]][x];
+            if (delay >= 0 && start[perm[j]] + delay > est) est = start[perm[j]] + delay;
+        }
+        start[x] = est;
+        machine_ready = est + op->duration;
+    }
+    return machine_ready;
+}
+
+// Helper: evaluate makespan of a permutation, any machine load
+static int evaluate_permutation_generic(OperationNode* nodes, int* ops_on_machine, const int* perm, int n) {
     int job_ready[MAX_JOBS] = { 0 };      // When each job is ready for its next op
     int machine_ready = 0;                // When the machine is ready for the next op
     int current_time = 0;
@@ -48,17 +91,23 @@ static int evaluate_permutation(OperationNode* nodes, int* ops_on_machine, const
 }
 
 // Helper: permute indices and track best
-static void permute(OperationNode* nodes, int* ops_on_machine, int* arr, int start, int n, int* best_makespan, int* best_perm) {
+static void permute(OperationNode* nodes, int* ops_on_machine, int* arr, int start, int n, const DelayedPrecedences* delays, int* best_makespan, int* best_perm) {
     if (start == n) {
 
         // Print the current permutation (local indices and global node indices)
-        printf("Permutation (local): ");
-        for (int i = 0; i < n; ++i) printf("%d ", arr[i]);
-        printf("| Global: ");
-        for (int i = 0; i < n; ++i) printf("%d ", ops_on_machine[arr[i]]);
+        // printf("Permutation (local): "); // DEBUG
+        // for (int i = 0; i < n; ++i) printf("%d ", arr[i]);
+        // printf("| Global: ");
+        // for (int i = 0; i < n; ++i) printf("%d ", ops_on_machine[arr[i]]);
 
-        int makespan = evaluate_permutation(nodes, ops_on_machine, arr, n);
-        printf("makespan: %d\n", makespan);
+        if (violates_fixed_arcs(nodes, ops_on_machine, arr, n, delays)) {
+            // printf("violates fixed arcs\n"); // DEBUG
+            return;
+        }
+
+        int makespan = delays != NULL ? evaluate_with_delays(nodes, ops_on_machine, arr, n, delays)
+            : evaluate_permutation_generic(nodes, ops_on_machine, arr, n);
+        // printf("makespan: %d\n", makespan); // DEBUG
         
         if (makespan < *best_makespan) {
             *best_makespan = makespan;
@@ -68,33 +117,563 @@ static void permute(OperationNode* nodes, int* ops_on_machine, int* arr, int sta
     }
     for (int i = start; i < n; i++) {
         int tmp = arr[start]; arr[start] = arr[i]; arr[i] = tmp;
-        permute(nodes, ops_on_machine, arr, start + 1, n, best_makespan, best_perm);
+        permute(nodes, ops_on_machine, arr, start + 1, n, delays, best_makespan, best_perm);
         tmp = arr[start]; arr[start] = arr[i]; arr[i] = tmp; // backtrack
     }
 }
 
+/**
+ * Copies a machine's releases and durations into the fixed arrays the kernels read.
+ * The distinct-job check happens here once, so the kernels never repeat it.
+ * @param nodes Global array of OperationNode
+ * @param ops_on_machine Array of indices of operations on the machine
+ * @param n Number of operations on machine
+ * @param load Output
+ * @return false if there is no kernel for n or two operations share a job
+ */
+bool load_machine_operations(const OperationNode* nodes, const int* ops_on_machine, int n, MachineLoad* load) {
+    if (n < 1 || n > SSMS_KERNEL_MAX_OPS) return false;
+
+    uint64_t jobs = 0;
+    for (int i = 0; i < n; i++) {
+        const OperationNode* op = &nodes[ops_on_machine[i]];
+        uint64_t job = 1ull << op->job_id;
+        if (jobs & job) return false;
+        jobs |= job;
+
+        load->release[i] = op->earliest_start;
+        load->duration[i] = op->duration;
+        load->predecessors[i] = 0;
+    }
+    load->num_ops = n;
+    return true;
+}
+
+// Loads the machine with the delayed precedences or, without them, the direct arcs
+// between its operations. False where load_machine_operations fails.
+static bool load_machine(OperationNode* nodes, const int* ops_on_machine, int n, const DelayedPrecedences* delays, MachineLoad* load) {
+    if (!load_machine_operations(nodes, ops_on_machine, n, load)) return false;
+
+    for (int i = 0; i < n; i++) {
+        for (int x = 0; x < n; x++) {
+            if (delays != NULL) load->delay[i][x] = delays->delay[i][x];
+            else load->delay[i][x] = x != i && has_successor(&nodes[ops_on_machine[i]], ops_on_machine[x]) ? load->duration[i] : -1;
+            if (load->delay[i][x] >= 0) load->predecessors[x] |= 1u << i;
+        }
+    }
+    return true;
+}
+
+// Kernels for a fixed load N, reading only the MachineLoad. Jobs on one machine are distinct
+// (checked when loading), so an operation starts at max(machine free, release) and no
+// job_ready array is needed. The brute force builds each
+// permutation in the order of permute() (same best sequence on ties), extends the prefix
+// makespan one operation at a time, delaying each operation behind its sequenced
+// predecessors, and cuts prefixes that place an operation before a predecessor or
+// already reach the best makespan.
+#define DEFINE_SSMS_KERNELS(N) \
+    static int evaluate_permutation_##N(const MachineLoad* load, const int* perm) { \
+        int end = 0; \
+        for (int i = 0; i < N; i++) { \
+            int x = perm[i]; \
+            int start = end > load->release[x] ? end : load->release[x]; \
+            end = start + load->duration[x]; \
+        } \
+        return end; \
+    } \
+    static void permute_##N(const MachineLoad* load, int* arr, int start, int ready, uint32_t placed, int* started, int* best_makespan, int* best_perm) { \
+        if (start == N) { \
+            *best_makespan = ready; \
+            memcpy(best_perm, arr, N * sizeof(int)); \
+            return; \
+        } \
+        for (int i = start; i < N; i++) { \
+            int x = arr[i]; \
+            if (load->predecessors[x] & ~placed) continue; \
+            int begin = ready > load->release[x] ? ready : load->release[x]; \
+            for (uint32_t preds = load->predecessors[x]; preds != 0; preds &= preds - 1) { \
+                int p = __builtin_ctz(preds); \
+                if (started[p] + load->delay[p][x] > begin) begin = started[p] + load->delay[p][x]; \
+            } \
+            int end = begin + load->duration[x]; \
+            if (end >= *best_makespan) continue; \
+            started[x] = begin; \
+            arr[i] = arr[start]; arr[start] = x; \
+            permute_##N(load, arr, start + 1, end, placed | 1u << x, started, best_makespan, best_perm); \
+            arr[start] = arr[i]; arr[i] = x; \
+        } \
+    } \
+    static int solve_bf_##N(const MachineLoad* load, int* best_perm) { \
+        int indices[N]; \
+        int started[N]; \
+        int best_makespan = INT_MAX; \
+        for (int i = 0; i < N; i++) indices[i] = i; \
+        permute_##N(load, indices, 0, 0, 0, started, &best_makespan, best_perm); \
+        return best_makespan; \
+    }
+
+#define SSMS_KERNEL_SIZES(X) \
+    X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) \
+    X(9) X(10) X(11) X(12) X(13) X(14) X(15) X(16)
+
+SSMS_KERNEL_SIZES(DEFINE_SSMS_KERNELS)
+
+typedef int (*EvaluateKernel)(const MachineLoad*, const int*);
+typedef int (*SolveKernel)(const MachineLoad*, int*);
+
+#define EVALUATE_KERNEL_ENTRY(N) [N] = evaluate_permutation_##N,
+#define SOLVE_KERNEL_ENTRY(N) [N] = solve_bf_##N,
+
+static const EvaluateKernel evaluate_kernels[SSMS_KERNEL_MAX_OPS + 1] = { SSMS_KERNEL_SIZES(EVALUATE_KERNEL_ENTRY) };
+static const SolveKernel solve_kernels[SSMS_KERNEL_MAX_OPS + 1] = { SSMS_KERNEL_SIZES(SOLVE_KERNEL_ENTRY) };
+
+/**
+ * Makespan of a loaded machine sequence, computed by the kernel for its size.
+ * @param load Filled by load_machine_operations
+ * @param perm Processing order as indices into ops_on_machine
+ * @return completion time of the last operation
+ */
+int evaluate_loaded_permutation(const MachineLoad* load, const int* perm) {
+    return evaluate_kernels[load->num_ops](load, perm);
+}
+
+/**
+ * Makespan of one machine sequence; loads the machine and dispatches to the kernel for n
+ * when there is one.
+ * @param nodes Global array of OperationNode
+ * @param ops_on_machine Array of indices of operations on the machine
+ * @param perm Processing order as indices into ops_on_machine
+ * @param n Number of operations on machine
+ * @return completion time of the last operation
+ */
+int evaluate_permutation(OperationNode* nodes, int* ops_on_machine, const int* perm, int n) {
+    MachineLoad load;
+    if (load_machine_operations(nodes, ops_on_machine, n, &load)) return evaluate_loaded_permutation(&load, perm);
+    return evaluate_permutation_generic(nodes, ops_on_machine, perm, n);
+}
+
 /**
  * Solve the single-machine sequencing subproblem by brute force,
  * using indices into the global OperationNode array.
+ * Loads up to SSMS_KERNEL_MAX_OPS go to the specialized kernel for their size.
  *
  * @param nodes Global array of OperationNode
  * @param ops_on_machine Array of indices of operations on the machine
  * @param n Number of operations on machine
+ * @param delays Delayed precedences among the machine's operations, or NULL for direct arcs only
  * @param best_sequence Output: array of indices into global nodes for best sequence (preallocated)
  * @return best makespan found
  */
-int solve_single_machine_subproblem_bf(OperationNode* nodes, int* ops_on_machine, int num_ops, int* best_sequence) {
+int solve_single_machine_subproblem_bf(OperationNode* nodes, int* ops_on_machine, int num_ops, const DelayedPrecedences* delays, int* best_sequence) {
     if (num_ops == 0) return 0;
 
     int indices[MAX_OPS_PER_MACHINE];
     int best_perm[MAX_OPS_PER_MACHINE];
     int best_makespan = INT_MAX;
 
-    for (int i = 0; i < num_ops; ++i)
+    for (int i = 0; i < num_ops; ++i) {
         indices[i] = i;
+        best_perm[i] = i;
+    }
+
+    MachineLoad load;
+    if (num_ops <= SSMS_KERNEL_MAX_OPS && load_machine(nodes, ops_on_machine, num_ops, delays, &load)) {
+        best_makespan = solve_kernels[num_ops](&load, best_perm);
+        memcpy(best_sequence, best_perm, num_ops * sizeof(int));
+        return best_makespan;
+    }
 
-    permute(nodes, ops_on_machine, indices, 0, num_ops, &best_makespan, best_perm);
+    permute(nodes, ops_on_machine, indices, 0, num_ops, delays, &best_makespan, best_perm);
 
     memcpy(best_sequence, best_perm, num_ops * sizeof(int));
     return best_makespan;
 }
+
+/**
+ * Derives the delayed precedences of one machine (Dauzère-Pérès/Lasserre): one longest-path
+ * sweep over the topological order per operation gives, for every other operation of the
+ * machine it reaches, the minimum distance between their starts.
+ * @param nodes Global array of OperationNode, acyclic
+ * @param order Topological order of all nodes (e.g. CriticalPath.order)
+ * @param num_operations Number of nodes
+ * @param ops_on_machine Array of indices of operations on the machine
+ * @param num_ops Number of operations on machine
+ * @param delays Output: delay[i][j] >= 0 if ops_on_machine[i] reaches ops_on_machine[j], else -1
+ */
+void compute_delayed_precedences(OperationNode* nodes, const int* order, int num_operations, const int* ops_on_machine, int num_ops, DelayedPrecedences* delays) {
+    int distance[MAX_OPERATIONS];
+
+    delays->num_ops = num_ops;
+    for (int i = 0; i < num_ops; i++) {
+        for (int x = 0; x < num_operations; x++) distance[x] = -1;
+        distance[ops_on_machine[i]] = 0;
+
+        for (int k = 0; k < num_operations; k++) {
+            int x = order[k];
+            if (distance[x] < 0) continue;
+            int reach = distance[x] + nodes[x].duration;
+            for (int s = 0; s < nodes[x].num_successors; s++) {
+                int succ = nodes[x].successors[s];
+                if (reach > distance[succ]) distance[succ] = reach;
+            }
+        }
+
+        for (int j = 0; j < num_ops; j++) {
+            delays->delay[i][j] = j == i ? -1 : distance[ops_on_machine[j]];
+        }
+    }
+}
+
+/**
+ * Schrage's heuristic on the head-body-tail relaxation of one machine.
+ * With delays, an operation becomes available only once every operation that reaches it
+ * is sequenced, and its release grows to the start of each such operation plus the delay,
+ * so the sequence never contradicts a path of the graph (zero durations included).
+ *
+ * @param nodes Global array of OperationNode
+ * @param ops_on_machine Array of indices of operations on the machine
+ * @param num_ops Number of operations on machine
+ * @param head Earliest start of every node
+ * @param tail Longest path after every node completes
+ * @param delays Delayed precedences among the machine's operations, or NULL
+ * @param best_sequence Output: indices into ops_on_machine in processing order
+ * @return max completion + tail over the machine
+ */
+int solve_single_machine_subproblem_schrage(OperationNode* nodes, int* ops_on_machine, int num_ops, const int* head, const int* tail, const DelayedPrecedences* delays, int* best_sequence) {
+    bool scheduled[MAX_OPS_PER_MACHINE] = { false };
+    int release[MAX_OPS_PER_MACHINE];
+    int pending[MAX_OPS_PER_MACHINE] = { 0 };   // Unsequenced operations that reach this one
+    int time = 0;
+    int lmax = 0;
+
+    for (int i = 0; i < num_ops; i++) {
+        release[i] = head[ops_on_machine[i]];
+        for (int k = 0; delays != NULL && k < num_ops; k++) {
+            if (delays->delay[k][i] >= 0) pending[i]++;
+        }
+    }
+
+    for (int k = 0; k < num_ops; k++) {
+        int pick = -1;
+        int earliest = -1;
+
+        for (int i = 0; i < num_ops; i++) {
+            if (scheduled[i] || pending[i] > 0) continue;
+            int op = ops_on_machine[i];
+            if (earliest < 0 || release[i] < release[earliest]) earliest = i;
+            if (release[i] <= time && (pick < 0 || tail[op] > tail[ops_on_machine[pick]])) pick = i;
+        }
+        if (pick < 0) {
+            // Machine idles until the next release
+            pick = earliest;
+            time = release[pick];
+        }
+
+        int op = ops_on_machine[pick];
+        scheduled[pick] = true;
+        best_sequence[k] = pick;
+        for (int i = 0; delays != NULL && i < num_ops; i++) {
+            int delay = delays->delay[pick][i];
+            if (delay < 0) continue;
+            pending[i]--;
+            if (time + delay > release[i]) release[i] = time + delay;
+        }
+        time += nodes[op].duration;
+        if (time + tail[op] > lmax) lmax = time + tail[op];
+    }
+
+    return lmax;
+}
+
+/**
+ * Lower bound from Jackson's preemptive schedule: at every release or completion the
+ * machine runs the released operation with the largest tail, preempting if needed.
+ * This solves 1|r_j,q_j,pmtn|Lmax exactly, which relaxes the machine's subproblem.
+ *
+ * @param nodes Global array of OperationNode
+ * @param ops_on_machine Array of indices of operations on the machine
+ * @param num_ops Number of operations on machine
+ * @param head Earliest start of every node
+ * @param tail Longest path after every node completes
+ * @return max completion + tail of the preemptive schedule
+ */
+int one_machine_preemptive_bound(OperationNode* nodes, int* ops_on_machine, int num_ops, const int* head, const int* tail) {
+    int remaining[MAX_OPS_PER_MACHINE];
+    int done = 0;
+    int time = INT_MAX;
+    int bound = 0;
+
+    for (int i = 0; i < num_ops; i++) {
+        remaining[i] = nodes[ops_on_machine[i]].duration;
+        if (head[ops_on_machine[i]] < time) time = head[ops_on_machine[i]];
+    }
+
+    while (done < num_ops) {
+        int pick = -1;
+        int next_release = INT_MAX;
+
+        for (int i = 0; i < num_ops; i++) {
+            if (remaining[i] == 0) continue;
+            int op = ops_on_machine[i];
+            if (head[op] <= time) {
+                if (pick < 0 || tail[op] > tail[ops_on_machine[pick]]) pick = i;
+            }
+            else if (head[op] < next_release) {
+                next_release = head[op];
+            }
+        }
+
+        if (pick < 0) {
+            time = next_release;
+            continue;
+        }
+
+        // Run until completion or until the next release may preempt
+        int run = remaining[pick];
+        if (next_release != INT_MAX && next_release - time < run) run = next_release - time;
+        time += run;
+        remaining[pick] -= run;
+        if (remaining[pick] == 0) {
+            done++;
+            if (time + tail[ops_on_machine[pick]] > bound) bound = time + tail[ops_on_machine[pick]];
+        }
+    }
+
+    return bound;
+}
+
+#define IMPROVE_MAX_MOVES 1000
+
+static void evaluate_batch_scalar(const SequenceBatch* batch, int* cmax, int* lmax) {
+    int end[SSMS_BATCH_LANES] = { 0 };
+    int worst[SSMS_BATCH_LANES] = { 0 };
+    for (int p = 0; p < batch->num_ops; p++) {
+        for (int l = 0; l < SSMS_BATCH_LANES; l++) {
+            int start = end[l] > batch->release[p][l] ? end[l] : batch->release[p][l];
+            end[l] = start + batch->duration[p][l];
+            if (end[l] + batch->tail[p][l] > worst[l]) worst[l] = end[l] + batch->tail[p][l];
+        }
+    }
+    memcpy(cmax, end, sizeof(end));
+    memcpy(lmax, worst, sizeof(worst));
+}
+
+#ifdef SSMS_BATCH_X86
+// The lanes run independent max/add chains; several registers per row hide their latency.
+__attribute__((target("sse4.1")))
+static void evaluate_batch_sse41(const SequenceBatch* batch, int* cmax, int* lmax) {
+    __m128i end[4], worst[4];
+    for (int r = 0; r < 4; r++) end[r] = worst[r] = _mm_setzero_si128();
+    for (int p = 0; p < batch->num_ops; p++) {
+        for (int r = 0; r < 4; r++) {
+            __m128i release = _mm_loadu_si128((const __m128i*)&batch->release[p][4 * r]);
+            __m128i duration = _mm_loadu_si128((const __m128i*)&batch->duration[p][4 * r]);
+            __m128i tail = _mm_loadu_si128((const __m128i*)&batch->tail[p][4 * r]);
+            end[r] = _mm_add_epi32(_mm_max_epi32(end[r], release), duration);
+            worst[r] = _mm_max_epi32(worst[r], _mm_add_epi32(end[r], tail));
+        }
+    }
+    for (int r = 0; r < 4; r++) {
+        _mm_storeu_si128((__m128i*)&cmax[4 * r], end[r]);
+        _mm_storeu_si128((__m128i*)&lmax[4 * r], worst[r]);
+    }
+}
+
+__attribute__((target("avx2")))
+static void evaluate_batch_avx2(const SequenceBatch* batch, int* cmax, int* lmax) {
+    __m256i end[2], worst[2];
+    for (int r = 0; r < 2; r++) end[r] = worst[r] = _mm256_setzero_si256();
+    for (int p = 0; p < batch->num_ops; p++) {
+        for (int r = 0; r < 2; r++) {
+            __m256i release = _mm256_loadu_si256((const __m256i*)&batch->release[p][8 * r]);
+            __m256i duration = _mm256_loadu_si256((const __m256i*)&batch->duration[p][8 * r]);
+            __m256i tail = _mm256_loadu_si256((const __m256i*)&batch->tail[p][8 * r]);
+            end[r] = _mm256_add_epi32(_mm256_max_epi32(end[r], release), duration);
+            worst[r] = _mm256_max_epi32(worst[r], _mm256_add_epi32(end[r], tail));
+        }
+    }
+    for (int r = 0; r < 2; r++) {
+        _mm256_storeu_si256((__m256i*)&cmax[8 * r], end[r]);
+        _mm256_storeu_si256((__m256i*)&lmax[8 * r], worst[r]);
+    }
+}
+#endif
+
+typedef void (*BatchKernel)(const SequenceBatch*, int*, int*);
+
+static BatchKernel batch_kernel = evaluate_batch_scalar;
+
+bool batch_isa_supported(BatchIsa isa) {
+    switch (isa) {
+    case BATCH_SCALAR:
+        return true;
+#ifdef SSMS_BATCH_X86
+    case BATCH_SSE41:
+        return __builtin_cpu_supports("sse4.1");
+    case BATCH_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+const char* batch_isa_name(BatchIsa isa) {
+    static const char* names[NUM_BATCH_ISAS] = { "scalar", "sse4.1", "avx2" };
+    return isa >= 0 && isa < NUM_BATCH_ISAS ? names[isa] : "unknown";
+}
+
+static BatchKernel batch_kernel_for(BatchIsa isa) {
+    if (!batch_isa_supported(isa)) return NULL;
+#ifdef SSMS_BATCH_X86
+    if (isa == BATCH_SSE41) return evaluate_batch_sse41;
+    if (isa == BATCH_AVX2) return evaluate_batch_avx2;
+#endif
+    return evaluate_batch_scalar;
+}
+
+// Runs before main, so the kernel never changes while solvers use it
+__attribute__((constructor))
+static void select_batch_kernel(void) {
+#ifdef SSMS_BATCH_X86
+    __builtin_cpu_init();
+#endif
+    for (int isa = NUM_BATCH_ISAS - 1; isa >= 0; isa--) {
+        if (batch_isa_supported(isa)) {
+            batch_kernel = batch_kernel_for(isa);
+            break;
+        }
+    }
+}
+
+/**
+ * Evaluates SSMS_BATCH_LANES sequences of one machine at once.
+ * @param batch Transposed release/duration/tail rows, one sequence per lane
+ * @param cmax Output: SSMS_BATCH_LANES completion times of the last operation
+ * @param lmax Output: SSMS_BATCH_LANES maxima of completion + tail
+ */
+void evaluate_sequence_batch(const SequenceBatch* batch, int* cmax, int* lmax) {
+    batch_kernel(batch, cmax, lmax);
+}
+
+int evaluate_sequence_batch_isa(BatchIsa isa, const SequenceBatch* batch, int* cmax, int* lmax) {
+    BatchKernel kernel = batch_kernel_for(isa);
+    if (kernel == NULL) return -1;
+    kernel(batch, cmax, lmax);
+    return 0;
+}
+
+// Helper: Lmax of a sequence where every operation also waits for the delayed precedences
+// of the operations sequenced before it (the semantics of the Schrage solver)
+static int sequence_lmax(OperationNode* nodes, const int* ops_on_machine, const int* sequence, int n, const int* head, const int* tail, const DelayedPrecedences* delays) {
+    int start[MAX_OPS_PER_MACHINE];     // By position in ops_on_machine
+    int time = 0;
+    int lmax = 0;
+    for (int k = 0; k < n; k++) {
+        int x = sequence[k];
+        int op = ops_on_machine[x];
+        int begin = time > head[op] ? time : head[op];
+        for (int j = 0; delays != NULL && j < k; j++) {
+            int delay = delays->delay[sequence[j]][x];
+            if (delay >= 0 && start[sequence[j]] + delay > begin) begin = start[sequence[j]] + delay;
+        }
+        start[x] = begin;
+        time = begin + nodes[op].duration;
+        if (time + tail[op] > lmax) lmax = time + tail[op];
+    }
+    return lmax;
+}
+
+/**
+ * Fills the batch with rest (the sequence without x) after inserting x at target[l] in lane l.
+ * Row p of lane l holds rest[p] before the target, x at it and rest[p - 1] after it.
+ */
+static void fill_insertion_batch(SequenceBatch* batch, const int* rest, int n, int x, const int* target,
+    const int* release, const int* duration, const int* tail) {
+    batch->num_ops = n;
+    for (int p = 0; p < n; p++) {
+        int before = rest[p < n - 1 ? p : n - 2];   // Lanes whose target is past p
+        int after = rest[p > 0 ? p - 1 : 0];        // Lanes whose target is before p
+        for (int l = 0; l < SSMS_BATCH_LANES; l++) {
+            int y = p < target[l] ? before : p == target[l] ? x : after;
+            batch->release[p][l] = release[y];
+            batch->duration[p][l] = duration[y];
+            batch->tail[p][l] = tail[y];
+        }
+    }
+}
+
+/**
+ * Improves a single-machine sequence for max completion + tail by first-improvement
+ * insertion moves: for each operation, all positions it can move to without passing an
+ * operation it must precede or follow are screened in batches; the best one is kept if
+ * its exact Lmax, delayed precedences included, is lower.
+ * @param nodes Global array of OperationNode
+ * @param ops_on_machine Array of indices of operations on the machine
+ * @param num_ops Number of operations on machine
+ * @param head Earliest start of every node
+ * @param tail Longest path after every node completes
+ * @param delays Delayed precedences among the machine's operations, or NULL
+ * @param sequence In/out: indices into ops_on_machine in processing order
+ * @return max completion + tail of the returned sequence
+ */
+int improve_single_machine_sequence(OperationNode* nodes, int* ops_on_machine, int num_ops, const int* head, const int* tail, const DelayedPrecedences* delays, int* sequence) {
+    int lmax = sequence_lmax(nodes, ops_on_machine, sequence, num_ops, head, tail, delays);
+    if (num_ops < 2) return lmax;
+
+    int release[MAX_OPS_PER_MACHINE], duration[MAX_OPS_PER_MACHINE], tails[MAX_OPS_PER_MACHINE];
+    for (int i = 0; i < num_ops; i++) {
+        release[i] = head[ops_on_machine[i]];
+        duration[i] = nodes[ops_on_machine[i]].duration;
+        tails[i] = tail[ops_on_machine[i]];
+    }
+
+    SequenceBatch batch;
+    int rest[MAX_OPS_PER_MACHINE], candidate[MAX_OPS_PER_MACHINE];
+    int target[SSMS_BATCH_LANES], cmax[SSMS_BATCH_LANES], lanes[SSMS_BATCH_LANES];
+
+    for (int moves = 0; moves < IMPROVE_MAX_MOVES; moves++) {
+        bool improved = false;
+        for (int a = 0; a < num_ops && !improved; a++) {
+            int x = sequence[a];
+
+            // x cannot pass an operation it must follow or precede
+            int lo = a, hi = a;
+            while (lo > 0 && !(delays != NULL && delays->delay[sequence[lo - 1]][x] >= 0)) lo--;
+            while (hi < num_ops - 1 && !(delays != NULL && delays->delay[x][sequence[hi + 1]] >= 0)) hi++;
+            if (lo == hi) continue;
+
+            for (int p = 0, k = 0; p < num_ops; p++) {
+                if (p != a) rest[k++] = sequence[p];
+            }
+
+            int best_target = -1, best_lmax = lmax;
+            for (int first = lo; first <= hi; first += SSMS_BATCH_LANES) {
+                for (int l = 0; l < SSMS_BATCH_LANES; l++) {
+                    target[l] = first + l <= hi ? first + l : hi;
+                }
+                fill_insertion_batch(&batch, rest, num_ops, x, target, release, duration, tails);
+                evaluate_sequence_batch(&batch, cmax, lanes);
+                for (int l = 0; l < SSMS_BATCH_LANES && first + l <= hi; l++) {
+                    if (first + l != a && lanes[l] < best_lmax) {
+                        best_lmax = lanes[l];
+                        best_target = first + l;
+                    }
+                }
+            }
+            if (best_target < 0) continue;
+
+            for (int p = 0, k = 0; p < num_ops; p++) {
+                candidate[p] = p == best_target ? x : rest[k++];
+            }
+            int exact = sequence_lmax(nodes, ops_on_machine, candidate, num_ops, head, tail, delays);
+            if (exact < lmax) {
+                memcpy(sequence, candidate, num_ops * sizeof(int));
+                lmax = exact;
+                improved = true;
+            }
+        }
+        if (!improved) break;
+    }
+    return lmax;
+}
@@ -0,0 +1,325 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "store.h"
+
+#define STORE_INDEX_MAGIC 0x58444e49u      // "INDX"
+#define STORE_RECORD_MAGIC 0x44434552u     // "RECD"
+#define STORE_VERSION 1
+#define FILE_PATH_LEN (STORE_PATH_LEN + 32)  // Store directory plus a file name
+
+#define FNV_OFFSET 14695981039346656037ull
+#define FNV_PRIME 1099511628211ull
+
+// Fixed part of a record, followed by int32 order[num_machines][num_jobs].
+typedef struct {
+    uint32_t magic;
+    uint32_t size;              // Whole record in bytes
+    uint64_t hash;
+    int32_t num_jobs;
+    int32_t num_machines;
+    int32_t makespan;
+    int32_t lower_bound;
+    int32_t proven_optimal;
+    uint32_t checksum;          // Low 32 bits of FNV-1a over the orders, catches torn appends
+} StoreRecordHeader;
+
+static uint64_t fnv1a(uint64_t hash, const void* bytes, size_t size) {
+    const unsigned char* p = bytes;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * Content hash of an instance, independent of the file it came from.
+ * @param data JSSP instance
+ * @return 64-bit FNV-1a of the dimensions and every (machine, duration) pair
+ */
+uint64_t hash_jssp_data(const JSSPData* data) {
+    int32_t dims[2] = { data->num_jobs, data->num_machines };
+    uint64_t hash = fnv1a(FNV_OFFSET, dims, sizeof(dims));
+    for (int j = 0; j < data->num_jobs; j++) {
+        for (int o = 0; o < data->num_machines; o++) {
+            int32_t task[2] = { data->operations[j][o].machine, data->operations[j][o].duration };
+            hash = fnv1a(hash, task, sizeof(task));
+        }
+    }
+    return hash;
+}
+
+static void store_path(const SolutionStore* store, const char* name, char* path) {
+    snprintf(path, FILE_PATH_LEN, "%s/%s", store->dir, name);
+}
+
+static void unmap_index(SolutionStore* store) {
+    if (store->index != NULL) munmap((void*)store->index, store->index_size);
+    store->index = NULL;
+    store->index_size = 0;
+}
+
+// Maps the published index; a missing or malformed file leaves the store empty.
+static void map_index(SolutionStore* store) {
+    char path[FILE_PATH_LEN];
+    struct stat st;
+
+    unmap_index(store);
+    store_path(store, "index.bin", path);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(StoreIndexHeader)) {
+        void* mapped = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped != MAP_FAILED) {
+            const StoreIndexHeader* header = mapped;
+            if (header->magic == STORE_INDEX_MAGIC && header->version == STORE_VERSION
+                && sizeof(StoreIndexHeader) + header->num_entries * sizeof(StoreIndexEntry) <= (size_t)st.st_size) {
+                store->index = header;
+                store->index_size = st.st_size;
+            }
+            else {
+                fprintf(stderr, "Store: ignoring malformed %s\n", path);
+                munmap(mapped, st.st_size);
+            }
+        }
+    }
+    close(fd);
+}
+
+static const StoreIndexEntry* index_entries(const SolutionStore* store) {
+    return (const StoreIndexEntry*)(store->index + 1);
+}
+
+static size_t index_count(const SolutionStore* store) {
+    return store->index != NULL ? store->index->num_entries : 0;
+}
+
+// Binary search; returns the position of hash or where it would be inserted.
+static size_t find_entry(const SolutionStore* store, uint64_t hash) {
+    const StoreIndexEntry* entries = index_entries(store);
+    size_t lo = 0, hi = index_count(store);
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (entries[mid].hash < hash) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static const StoreIndexEntry* lookup_entry(const SolutionStore* store, uint64_t hash) {
+    size_t pos = find_entry(store, hash);
+    if (pos < index_count(store) && index_entries(store)[pos].hash == hash) return &index_entries(store)[pos];
+    return NULL;
+}
+
+// Reads and checks the record at offset. Returns 0, or -1 if it does not belong to data.
+static int read_record(const SolutionStore* store, uint64_t offset, const JSSPData* data, MachineSequences* seq) {
+    StoreRecordHeader header;
+    if (pread(store->records_fd, &header, sizeof(header), offset) != (ssize_t)sizeof(header)) return -1;
+
+    size_t orders = (size_t)data->num_machines * data->num_jobs;
+    if (header.magic != STORE_RECORD_MAGIC || header.hash != hash_jssp_data(data)
+        || header.num_jobs != data->num_jobs || header.num_machines != data->num_machines
+        || header.size != sizeof(header) + orders * sizeof(int32_t)) {
+        return -1;
+    }
+
+    int32_t* order = malloc(orders * sizeof(int32_t));
+    ssize_t got = pread(store->records_fd, order, orders * sizeof(int32_t), offset + sizeof(header));
+    if (got != (ssize_t)(orders * sizeof(int32_t)) || (uint32_t)fnv1a(FNV_OFFSET, order, got) != header.checksum) {
+        free(order);
+        return -1;
+    }
+
+    seq->num_jobs = data->num_jobs;
+    seq->num_machines = data->num_machines;
+    for (int m = 0; m < data->num_machines; m++) {
+        seq->length[m] = data->num_jobs;
+        for (int i = 0; i < data->num_jobs; i++) seq->order[m][i] = order[m * data->num_jobs + i];
+    }
+    free(order);
+    return 0;
+}
+
+/**
+ * Opens (and if needed creates) a store directory and maps its index.
+ * @param dir Store directory
+ * @param store Output
+ * @return 0 on success, -1 on error
+ */
+int open_solution_store(const char* dir, SolutionStore* store) {
+    char path[FILE_PATH_LEN];
+
+    memset(store, 0, sizeof(*store));
+    snprintf(store->dir, sizeof(store->dir), "%s", dir);
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Store: cannot create %s\n", dir);
+        return -1;
+    }
+
+    store_path(store, "records.bin", path);
+    store->records_fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (store->records_fd < 0) {
+        fprintf(stderr, "Store: cannot open %s\n", path);
+        return -1;
+    }
+
+    map_index(store);
+    return 0;
+}
+
+void close_solution_store(SolutionStore* store) {
+    unmap_index(store);
+    if (store->records_fd >= 0) close(store->records_fd);
+    store->records_fd = -1;
+}
+
+/**
+ * Looks up the best stored solution of an instance.
+ * @param store Open store
+ * @param data JSSP instance
+ * @param seq Output: stored orientation, or NULL for the bounds only
+ * @param bounds Output: stored makespan and lower bound (may be NULL)
+ * @return stored makespan, or -1 if there is none
+ */
+int lookup_best_solution(const SolutionStore* store, const JSSPData* data, MachineSequences* seq, StoredBounds* bounds) {
+    const StoreIndexEntry* entry = lookup_entry(store, hash_jssp_data(data));
+    int makespan = -1;
+
+    if (entry != NULL && (seq == NULL || read_record(store, entry->offset, data, seq) == 0)) {
+        makespan = entry->makespan;
+    }
+    if (bounds != NULL) {
+        bounds->makespan = makespan;
+        bounds->lower_bound = makespan >= 0 ? entry->lower_bound : 0;
+        bounds->proven_optimal = makespan >= 0 && entry->proven_optimal;
+    }
+    return makespan;
+}
+
+// Writes entries to a temporary file and renames it over the index, so readers see
+// either the old or the new index and never a partial one.
+static int publish_index(SolutionStore* store, const StoreIndexEntry* entries, size_t count) {
+    char path[FILE_PATH_LEN], tmp_path[FILE_PATH_LEN];
+    StoreIndexHeader header = { STORE_INDEX_MAGIC, STORE_VERSION, count };
+
+    store_path(store, "index.bin", path);
+    store_path(store, "index.bin.tmp", tmp_path);
+    int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return -1;
+
+    bool ok = write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header)
+        && write(fd, entries, count * sizeof(StoreIndexEntry)) == (ssize_t)(count * sizeof(StoreIndexEntry))
+        && fsync(fd) == 0;
+    close(fd);
+    if (!ok || rename(tmp_path, path) != 0) {
+        unlink(tmp_path);
+        return -1;
+    }
+
+    map_index(store);
+    return 0;
+}
+
+/**
+ * Records a solution if it improves the stored makespan or lower bound.
+ * @param store Open store
+ * @param data JSSP instance
+ * @param seq Complete orientation with the given makespan
+ * @param makespan Makespan of seq
+ * @param lower_bound Proven lower bound, 0 if none
+ * @param proven_optimal makespan is optimal
+ * @return 1 if the store changed, 0 if not, -1 on error
+ */
+int record_solution(SolutionStore* store, const JSSPData* data, const MachineSequences* seq, int makespan,
+    int lower_bound, bool proven_optimal) {
+    static MachineSequences stored;
+    uint64_t hash = hash_jssp_data(data);
+    int status = 0;
+
+    for (int m = 0; m < data->num_machines; m++) {
+        if (seq->length[m] != data->num_jobs) return -1;
+    }
+
+    flock(store->records_fd, LOCK_EX);
+    map_index(store);   // Another run may have published since we opened
+
+    if (proven_optimal && makespan > lower_bound) lower_bound = makespan;
+    const StoreIndexEntry* entry = lookup_entry(store, hash);
+    const MachineSequences* keep = seq;
+    if (entry != NULL) {
+        bool better_solution = makespan < entry->makespan;
+        bool better_bound = lower_bound > entry->lower_bound;
+        if (!better_solution && !better_bound) goto unlock;
+        if (!better_solution) {
+            if (read_record(store, entry->offset, data, &stored) != 0) goto unlock;
+            keep = &stored;
+            makespan = entry->makespan;
+        }
+        if (entry->lower_bound > lower_bound) lower_bound = entry->lower_bound;
+    }
+
+    // 1. Append the record
+    size_t orders = (size_t)data->num_machines * data->num_jobs;
+    size_t size = sizeof(StoreRecordHeader) + orders * sizeof(int32_t);
+    unsigned char* record = malloc(size);
+    StoreRecordHeader* header = (StoreRecordHeader*)record;
+    int32_t* order = (int32_t*)(header + 1);
+    for (int m = 0; m < data->num_machines; m++) {
+        for (int i = 0; i < data->num_jobs; i++) order[m * data->num_jobs + i] = keep->order[m][i];
+    }
+    *header = (StoreRecordHeader){
+        .magic = STORE_RECORD_MAGIC,
+        .size = size,
+        .hash = hash,
+        .num_jobs = data->num_jobs,
+        .num_machines = data->num_machines,
+        .makespan = makespan,
+        .lower_bound = lower_bound,
+        .proven_optimal = lower_bound >= makespan,
+        .checksum = (uint32_t)fnv1a(FNV_OFFSET, order, orders * sizeof(int32_t)),
+    };
+
+    off_t offset = lseek(store->records_fd, 0, SEEK_END);
+    bool appended = offset >= 0 && write(store->records_fd, record, size) == (ssize_t)size
+        && fsync(store->records_fd) == 0;
+    free(record);
+    if (!appended) {
+        fprintf(stderr, "Store: cannot append to %s/records.bin\n", store->dir);
+        status = -1;
+        goto unlock;
+    }
+
+    // 2. Publish an index that points at it
+    size_t count = index_count(store);
+    size_t pos = find_entry(store, hash);
+    bool replace = entry != NULL;
+    size_t rest = count - pos - (replace ? 1 : 0);
+    StoreIndexEntry* entries = malloc((count + 1) * sizeof(StoreIndexEntry));
+    entries[pos] = (StoreIndexEntry){ hash, (uint64_t)offset, makespan, lower_bound, lower_bound >= makespan, 0 };
+    if (count > 0) {
+        memcpy(entries, index_entries(store), pos * sizeof(StoreIndexEntry));
+        memcpy(&entries[pos + 1], index_entries(store) + pos + (replace ? 1 : 0), rest * sizeof(StoreIndexEntry));
+    }
+
+    if (publish_index(store, entries, pos + 1 + rest) != 0) {
+        fprintf(stderr, "Store: cannot publish %s/index.bin\n", store->dir);
+        status = -1;
+    }
+    else {
+        status = 1;
+    }
+    free(entries);
+
+unlock:
+    flock(store->records_fd, LOCK_UN);
+    return status;
+}
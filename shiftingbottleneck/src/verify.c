@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "verify.h"
+
+typedef struct {
+    int start;
+    int end;
+    int job;
+    int op;
+} TimedOp;
+
+static void report_violation(VerificationReport* report, ViolationKind kind, int job, int op, int other_job, int other_op, int expected, int actual) {
+    if (report->num_reported < MAX_REPORTED_VIOLATIONS) {
+        ScheduleViolation* v = &report->violations[report->num_reported++];
+        v->kind = kind;
+        v->job = job;
+        v->op = op;
+        v->other_job = other_job;
+        v->other_op = other_op;
+        v->expected = expected;
+        v->actual = actual;
+    }
+    report->num_violations++;
+}
+
+static int compare_by_start(const void* a, const void* b) {
+    const TimedOp* x = a;
+    const TimedOp* y = b;
+    if (x->start != y->start) return x->start < y->start ? -1 : 1;
+    return x->end < y->end ? -1 : (x->end > y->end);
+}
+
+// Sorts one machine's operations by start and reports overlaps in a single sweep.
+// Returns the latest end on the machine.
+static int sweep_machine(TimedOp* ops, int size, VerificationReport* report) {
+    if (size == 0) return 0;
+    qsort(ops, size, sizeof(TimedOp), compare_by_start);
+
+    int latest = 0;  // Index of the op with the latest end so far
+    for (int i = 1; i < size; i++) {
+        if (ops[i].start < ops[latest].end) {
+            report_violation(report, VIOLATION_MACHINE_OVERLAP, ops[i].job, ops[i].op,
+                ops[latest].job, ops[latest].op, ops[latest].end, ops[i].start);
+        }
+        if (ops[i].end > ops[latest].end) latest = i;
+    }
+    return ops[latest].end;
+}
+
+/**
+ * Verifies a schedule without the pairwise overlap check of validate_schedule.
+ * Operations are bucketed by machine with a counting pass, each bucket is sorted by
+ * start time and swept once, keeping the operation with the latest end seen so far.
+ * @param sched Schedule to check
+ * @param data JSSP instance the schedule was built for
+ * @param claimed_makespan Makespan reported by the solver, or -1 to skip that check
+ * @param report Output: violation counts and the first MAX_REPORTED_VIOLATIONS details
+ * @return number of violations found
+ */
+int verify_schedule(const Schedule* sched, const JSSPData* data, int claimed_makespan, VerificationReport* report) {
+    TimedOp by_machine[MAX_OPERATIONS];
+    int offset[MAX_MACHINES + 1] = { 0 };
+    int fill[MAX_MACHINES];
+    int job_end[MAX_JOBS];
+    int machine_end[MAX_MACHINES] = { 0 };
+
+    report->num_violations = 0;
+    report->num_reported = 0;
+    report->makespan = 0;
+
+    // 1. Durations and precedence, one pass per job
+    for (int j = 0; j < data->num_jobs; j++) {
+        job_end[j] = 0;
+        for (int o = 0; o < data->num_machines; o++) {
+            int start = sched->start_time[j][o];
+            int end = sched->end_time[j][o];
+            int duration = data->operations[j][o].duration;
+
+            if (start < 0 || end - start != duration) {
+                report_violation(report, VIOLATION_BAD_TIMES, j, o, -1, -1, duration, end - start);
+            }
+            if (o > 0 && start < sched->end_time[j][o - 1]) {
+                report_violation(report, VIOLATION_PRECEDENCE, j, o, j, o - 1, sched->end_time[j][o - 1], start);
+            }
+            if (end > job_end[j]) job_end[j] = end;
+
+            // Left out of the machine buckets, which it would index out of bounds
+            int machine = data->operations[j][o].machine;
+            if (machine < 0 || machine >= data->num_machines) {
+                report_violation(report, VIOLATION_BAD_MACHINE, j, o, -1, -1, data->num_machines, machine);
+                continue;
+            }
+            offset[machine + 1]++;
+        }
+        if (job_end[j] > report->makespan) report->makespan = job_end[j];
+    }
+
+    // 2. Bucket by machine (counting sort), then sort each bucket by start time
+    for (int m = 0; m < data->num_machines; m++) {
+        offset[m + 1] += offset[m];
+        fill[m] = offset[m];
+    }
+    for (int j = 0; j < data->num_jobs; j++) {
+        for (int o = 0; o < data->num_machines; o++) {
+            int machine = data->operations[j][o].machine;
+            if (machine < 0 || machine >= data->num_machines) continue;
+            TimedOp* t = &by_machine[fill[machine]++];
+            t->start = sched->start_time[j][o];
+            t->end = sched->end_time[j][o];
+            t->job = j;
+            t->op = o;
+        }
+    }
+
+    for (int m = 0; m < data->num_machines; m++) {
+        machine_end[m] = sweep_machine(&by_machine[offset[m]], offset[m + 1] - offset[m], report);
+    }
+
+    // 3. Ready times and makespan must agree with the end times
+    for (int j = 0; j < data->num_jobs; j++) {
+        if (sched->job_ready[j] != job_end[j]) {
+            report_violation(report, VIOLATION_READY_TIME, j, -1, -1, -1, job_end[j], sched->job_ready[j]);
+        }
+    }
+    for (int m = 0; m < data->num_machines; m++) {
+        if (sched->machine_ready[m] != machine_end[m]) {
+            report_violation(report, VIOLATION_READY_TIME, -1, -1, m, -1, machine_end[m], sched->machine_ready[m]);
+        }
+    }
+    if (claimed_makespan >= 0 && claimed_makespan != report->makespan) {
+        report_violation(report, VIOLATION_MAKESPAN, -1, -1, -1, -1, report->makespan, claimed_makespan);
+    }
+
+    return report->num_violations;
+}
+
+/**
+ * Same checks for instances of any size, given as start times next to the loader matrix.
+ * Durations come from the matrix, so only machine ids, precedence, overlap and makespan can fail.
+ * @param matrix Instance in loader layout (machine/duration pairs per job)
+ * @param start_times Start time of every operation, one row per job
+ * @param num_jobs Rows of both matrices
+ * @param num_machines Operations per job
+ * @param claimed_makespan Makespan reported by the solver, or -1 to skip that check
+ * @param report Output
+ * @return number of violations found
+ */
+int verify_start_times(int** matrix, int** start_times, int num_jobs, int num_machines, int claimed_makespan, VerificationReport* report) {
+    TimedOp* by_machine = malloc((size_t)num_jobs * num_machines * sizeof(TimedOp));
+    int* offset = calloc(num_machines + 1, sizeof(int));
+    int* fill = malloc(num_machines * sizeof(int));
+
+    report->num_violations = 0;
+    report->num_reported = 0;
+    report->makespan = 0;
+
+    for (int j = 0; j < num_jobs; j++) {
+        for (int o = 0; o < num_machines; o++) {
+            int start = start_times[j][o];
+            int end = start + matrix[j][2 * o + 1];
+            if (start < 0) {
+                report_violation(report, VIOLATION_BAD_TIMES, j, o, -1, -1, 0, start);
+            }
+            if (o > 0) {
+                int previous_end = start_times[j][o - 1] + matrix[j][2 * o - 1];
+                if (start < previous_end) {
+                    report_violation(report, VIOLATION_PRECEDENCE, j, o, j, o - 1, previous_end, start);
+                }
+            }
+            if (end > report->makespan) report->makespan = end;
+
+            int machine = matrix[j][2 * o];
+            if (machine < 0 || machine >= num_machines) {
+                report_violation(report, VIOLATION_BAD_MACHINE, j, o, -1, -1, num_machines, machine);
+                continue;
+            }
+            offset[machine + 1]++;
+        }
+    }
+
+    for (int m = 0; m < num_machines; m++) {
+        offset[m + 1] += offset[m];
+        fill[m] = offset[m];
+    }
+    for (int j = 0; j < num_jobs; j++) {
+        for (int o = 0; o < num_machines; o++) {
+            int machine = matrix[j][2 * o];
+            if (machine < 0 || machine >= num_machines) continue;
+            TimedOp* t = &by_machine[fill[machine]++];
+            t->start = start_times[j][o];
+            t->end = t->start + matrix[j][2 * o + 1];
+            t->job = j;
+            t->op = o;
+        }
+    }
+    for (int m = 0; m < num_machines; m++) {
+        sweep_machine(&by_machine[offset[m]], offset[m + 1] - offset[m], report);
+    }
+
+    if (claimed_makespan >= 0 && claimed_makespan != report->makespan) {
+        report_violation(report, VIOLATION_MAKESPAN, -1, -1, -1, -1, report->makespan, claimed_makespan);
+    }
+
+    free(by_machine);
+    free(offset);
+    free(fill);
+    return report->num_violations;
+}
+
+void print_verification_report(const VerificationReport* report) {
+    if (report->num_violations == 0) {
+        printf("Schedule verified: makespan %d, no violations.\n", report->makespan);
+        return;
+    }
+
+    printf("Schedule verification failed: %d violation(s), makespan %d\n", report->num_violations, report->makespan);
+    for (int i = 0; i < report->num_reported; i++) {
+        const ScheduleViolation* v = &report->violations[i];
+        switch (v->kind) {
+        case VIOLATION_BAD_TIMES:
+            printf("  Job %d Op %d: duration %d expected, schedule has %d\n", v->job, v->op, v->expected, v->actual);
+            break;
+        case VIOLATION_PRECEDENCE:
+            printf("  Job %d Op %d starts at %d before Op %d ends at %d\n", v->job, v->op, v->actual, v->other_op, v->expected);
+            break;
+        case VIOLATION_MACHINE_OVERLAP:
+            printf("  Job %d Op %d starts at %d while Job %d Op %d runs until %d\n",
+                v->job, v->op, v->actual, v->other_job, v->other_op, v->expected);
+            break;
+        case VIOLATION_READY_TIME:
+            if (v->job >= 0) printf("  Job %d ready at %d, last op ends at %d\n", v->job, v->actual, v->expected);
+            else printf("  Machine %d ready at %d, last op ends at %d\n", v->other_job, v->actual, v->expected);
+            break;
+        case VIOLATION_MAKESPAN:
+            printf("  Claimed makespan %d, schedule ends at %d\n", v->actual, v->expected);
+            break;
+        case VIOLATION_BAD_MACHINE:
+            printf("  Job %d Op %d: machine %d is not in 0..%d\n", v->job, v->op, v->actual, v->expected - 1);
+            break;
+        }
+    }
+    if (report->num_violations > report->num_reported) {
+        printf("  ... %d more not shown\n", report->num_violations - report->num_reported);
+    }
+}